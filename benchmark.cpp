@@ -0,0 +1,902 @@
+//
+// Benchmarks de los caminos críticos de la red neuronal.
+// Compilar en Release (-O2/-O3) para obtener cifras representativas.
+//
+// Uso: pongsasos_bench [--suite] [--json ARCHIVO] [--filter TEXTO] [--samples N]
+//
+// Sin opciones imprime las tablas comparativas (implementación anterior vs
+// actual) y después la suite de regresión. Con --suite sólo corre la suite;
+// --json escribe sus resultados como JSON para comparar entre commits y
+// --filter elige los casos cuyo nombre contiene el texto.
+//
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <array>
+#include <functional>
+#include <memory>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "nn/tensor.h"
+#include "nn/network.h"
+#include "nn/quantized.h"
+#include "nn/spsc_queue.h"
+#include "benchmark_harness.h"
+#include "pong/self_play.h"
+#include "pong/training.h"
+#include "pong/vector_env.h"
+#include "pong/batched_policy.h"
+#include "pong/evolution.h"
+#include "pong/dqn.h"
+
+using namespace std;
+using namespace utec::algebra;
+using namespace utec::neural_network;
+
+// Repite func hasta acumular al menos min_seconds y devuelve segundos por llamada
+double time_per_call(const function<void()>& func, double min_seconds = 0.2) {
+    using clock = chrono::steady_clock;
+    func(); // calentamiento
+    size_t iterations = 0;
+    auto start = clock::now();
+    double elapsed = 0.0;
+    do {
+        func();
+        ++iterations;
+        elapsed = chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < min_seconds);
+    return elapsed / iterations;
+}
+
+// Implementación original de Tensor::matmul (bucle i-j-k con operator()),
+// conservada como referencia para comparar.
+Tensor<float, 2> naive_matmul(const Tensor<float, 2>& a, const Tensor<float, 2>& b) {
+    Tensor<float, 2> result(a.shape()[0], b.shape()[1]);
+    for (size_t i = 0; i < a.shape()[0]; ++i) {
+        for (size_t j = 0; j < b.shape()[1]; ++j) {
+            float sum = 0.0f;
+            for (size_t k = 0; k < a.shape()[1]; ++k) {
+                sum += a(i, k) * b(k, j);
+            }
+            result(i, j) = sum;
+        }
+    }
+    return result;
+}
+
+void bench_matmul() {
+    cout << "=== Tensor::matmul (formas de DenseLayer en AIPaddle 5->16->16->1) ===" << endl;
+    cout << "ISA detectada: " << gemm::isa_name(gemm::detected_isa()) << endl;
+    cout << left << setw(22) << "forma (MxK * KxN)" << right
+         << setw(12) << "naive" << setw(12) << "scalar"
+         << setw(12) << "avx2" << setw(12) << "avx512" << "   [GFLOP/s]" << endl;
+
+    const size_t batches[] = {1, 256, 16384, 131072};
+    const size_t layers[][2] = {{5, 16}, {16, 16}, {16, 1}};
+
+    for (size_t m : batches) {
+        for (const auto& layer : layers) {
+            size_t k = layer[0], n = layer[1];
+            Tensor<float, 2> a(m, k), b(k, n);
+            a.random_fill(-1.0f, 1.0f);
+            b.random_fill(-1.0f, 1.0f);
+            double flops = 2.0 * m * n * k;
+
+            string shape = to_string(m) + "x" + to_string(k) + " * " + to_string(k) + "x" + to_string(n);
+            cout << left << setw(22) << shape << right << fixed << setprecision(2);
+
+            double naive = time_per_call([&] { auto c = naive_matmul(a, b); });
+            cout << setw(12) << flops / naive * 1e-9;
+
+            for (gemm::Isa isa : {gemm::Isa::scalar, gemm::Isa::avx2, gemm::Isa::avx512}) {
+                if (static_cast<int>(isa) > static_cast<int>(gemm::detected_isa())) {
+                    cout << setw(12) << "-";
+                    continue;
+                }
+                gemm::force_isa(isa);
+                double t = time_per_call([&] { auto c = a.matmul(b); });
+                cout << setw(12) << flops / t * 1e-9;
+            }
+            gemm::force_isa(gemm::detected_isa());
+            cout << endl;
+        }
+    }
+    cout << endl;
+}
+
+// Backward de DenseLayer tal como era antes de matmul_tn/matmul_nt:
+// transpuestas materializadas en cada paso.
+void dense_backward_with_transposes(const Tensor<float, 2>& input, const Tensor<float, 2>& weights,
+                                    const Tensor<float, 2>& grad_output) {
+    auto weight_gradients = input.transpose().matmul(grad_output);
+    Tensor<float, 2> bias_gradients(1, grad_output.shape()[1]);
+    for (size_t j = 0; j < grad_output.shape()[1]; ++j) {
+        float sum = 0.0f;
+        for (size_t i = 0; i < grad_output.shape()[0]; ++i) {
+            sum += grad_output(i, j);
+        }
+        bias_gradients(0, j) = sum;
+    }
+    auto grad_input = grad_output.matmul(weights.transpose());
+}
+
+// Aritmética de Tensor tal como era antes de expression.h: cada operador
+// copia su operando izquierdo en un resultado nuevo
+Tensor<float, 2> eager_add(const Tensor<float, 2>& a, const Tensor<float, 2>& b, float sign) {
+    Tensor<float, 2> result = a;
+    for (size_t i = 0; i < result.size(); ++i) result.data()[i] += sign * b.data()[i];
+    return result;
+}
+
+Tensor<float, 2> eager_scale(const Tensor<float, 2>& a, float s) {
+    Tensor<float, 2> result = a;
+    for (size_t i = 0; i < result.size(); ++i) result.data()[i] *= s;
+    return result;
+}
+
+void bench_tensor_expressions() {
+    cout << "=== r = a + b * s - c: operadores con copias vs expresiones ===" << endl;
+    cout << left << setw(12) << "elementos" << right << setw(16) << "copias [us]"
+         << setw(16) << "perezoso [us]" << setw(16) << "+= [us]" << setw(10) << "x" << endl;
+
+    for (size_t n : {1024, 65536, 1048576}) {
+        Tensor<float, 2> a(n / 64, 64), b(n / 64, 64), c(n / 64, 64), r(n / 64, 64);
+        a.random_fill(-1.0f, 1.0f);
+        b.random_fill(-1.0f, 1.0f);
+        c.random_fill(-1.0f, 1.0f);
+
+        double eager = time_per_call([&] { r = eager_add(eager_add(a, eager_scale(b, 0.5f), 1.0f), c, -1.0f); });
+        double lazy = time_per_call([&] { r = a + b * 0.5f - c; });
+        double compound = time_per_call([&] { r += b * 0.5f; });
+        cout << left << setw(12) << n << right << fixed << setprecision(2)
+             << setw(16) << eager * 1e6 << setw(16) << lazy * 1e6 << setw(16) << compound * 1e6
+             << setw(10) << eager / lazy << endl;
+    }
+    cout << endl;
+}
+
+void bench_dense_backward() {
+    cout << "=== Backward de DenseLayer por época (5->16->16->1) ===" << endl;
+    cout << left << setw(10) << "batch" << right
+         << setw(18) << "transpose [ms]" << setw(18) << "fusionado [ms]" << setw(10) << "x" << endl;
+
+    const size_t layers[][2] = {{5, 16}, {16, 16}, {16, 1}};
+    for (size_t batch : {256, 16384, 131072}) {
+        vector<Tensor<float, 2>> inputs, weights, grads;
+        vector<DenseLayer<float>> dense;
+        for (const auto& layer : layers) {
+            inputs.emplace_back(batch, layer[0]);
+            weights.emplace_back(layer[0], layer[1]);
+            grads.emplace_back(batch, layer[1]);
+            inputs.back().random_fill(-1.0f, 1.0f);
+            weights.back().random_fill(-1.0f, 1.0f);
+            grads.back().random_fill(-1.0f, 1.0f);
+            dense.emplace_back(layer[0], layer[1]);
+            dense.back().forward(inputs.back());
+        }
+
+        double before = time_per_call([&] {
+            for (size_t l = 0; l < dense.size(); ++l) {
+                dense_backward_with_transposes(inputs[l], weights[l], grads[l]);
+            }
+        });
+        double after = time_per_call([&] {
+            for (size_t l = 0; l < dense.size(); ++l) {
+                auto g = dense[l].backward(grads[l]);
+            }
+        });
+
+        cout << left << setw(10) << batch << right << fixed << setprecision(3)
+             << setw(18) << before * 1e3 << setw(18) << after * 1e3
+             << setw(10) << setprecision(2) << before / after << endl;
+    }
+    cout << endl;
+}
+
+// Activaciones tal como eran antes de activation.h: una llamada virtual por
+// elemento, std::tanh, y el backward recalculando la función sobre la entrada.
+struct VirtualActivation {
+    virtual ~VirtualActivation() = default;
+    virtual float forward(float x) const = 0;
+    virtual float backward(float x) const = 0;
+};
+
+struct VirtualTanh : VirtualActivation {
+    float forward(float x) const override { return std::tanh(x); }
+    float backward(float x) const override {
+        float t = std::tanh(x);
+        return 1.0f - t * t;
+    }
+};
+
+void bench_activations() {
+    cout << "=== Activación tanh (capa oculta de 16 columnas) ===" << endl;
+    cout << left << setw(10) << "filas" << right << setw(14) << "virtual fwd"
+         << setw(12) << "scalar" << setw(12) << "avx2" << setw(12) << "avx512"
+         << setw(14) << "virtual bwd" << setw(12) << "scalar" << setw(12) << "avx2"
+         << setw(12) << "avx512" << "   [Melem/s]" << endl;
+
+    unique_ptr<VirtualActivation> reference = make_unique<VirtualTanh>();
+    for (size_t rows : {256, 16384, 131072}) {
+        size_t n = rows * 16;
+        Tensor<float, 2> input(rows, 16), grad(rows, 16), output(rows, 16), grad_input(rows, 16);
+        input.random_fill(-3.0f, 3.0f);
+        grad.random_fill(-1.0f, 1.0f);
+        const float* in = input.data();
+        const float* g = grad.data();
+        float* out = output.data();
+        float* gi = grad_input.data();
+
+        cout << left << setw(10) << rows << right << fixed << setprecision(0);
+        double t = time_per_call([&] {
+            for (size_t i = 0; i < n; ++i) out[i] = reference->forward(in[i]);
+        });
+        cout << setw(14) << n / t * 1e-6;
+        auto kernels = [&](const function<void()>& func) {
+            for (gemm::Isa isa : {gemm::Isa::scalar, gemm::Isa::avx2, gemm::Isa::avx512}) {
+                if (static_cast<int>(isa) > static_cast<int>(gemm::detected_isa())) {
+                    cout << setw(12) << "-";
+                    continue;
+                }
+                gemm::force_isa(isa);
+                cout << setw(12) << n / time_per_call(func) * 1e-6;
+            }
+            gemm::force_isa(gemm::detected_isa());
+        };
+        kernels([&] { Tanh<float>::forward(in, out, n); });
+
+        t = time_per_call([&] {
+            for (size_t i = 0; i < n; ++i) gi[i] = g[i] * reference->backward(in[i]);
+        });
+        cout << setw(14) << n / t * 1e-6;
+        kernels([&] { Tanh<float>::backward(g, out, gi, n); });
+        cout << endl;
+    }
+    cout << endl;
+}
+
+void bench_layer_fusion() {
+    cout << "=== Fusión Dense + bias + tanh (política 5->16->16->1) ===" << endl;
+    cout << left << setw(10) << "filas" << right
+         << setw(16) << "fwd separado" << setw(16) << "fwd fusionado"
+         << setw(16) << "train separado" << setw(16) << "train fusionado" << "   [ns/fila]" << endl;
+
+    for (size_t rows : {256, 16384, 131072}) {
+        Tensor<float, 2> X(rows, 5), y(rows, 1);
+        X.random_fill(-1.0f, 1.0f);
+        y.random_fill(-1.0f, 1.0f);
+
+        cout << left << setw(10) << rows << right << fixed << setprecision(2);
+        double forward[2], train[2];
+        for (int fused = 0; fused < 2; ++fused) {
+            auto network = utec::pong::make_policy_network();
+            network->set_layer_fusion(fused == 1);
+            network->set_num_threads(1);
+            network->set_batch_size(256, false);
+            forward[fused] = time_per_call([&] { network->predict_batch(X); });
+            train[fused] = time_per_call([&] { network->train(X, y, 1, false); });
+        }
+        cout << setw(16) << forward[0] * 1e9 / rows << setw(16) << forward[1] * 1e9 / rows
+             << setw(16) << train[0] * 1e9 / rows << setw(16) << train[1] * 1e9 / rows << endl;
+    }
+    cout << endl;
+}
+
+void bench_policy_decision() {
+    cout << "=== Una decisión del AIPaddle (5->16->16->1 tanh) ===" << endl;
+
+    auto network = utec::pong::make_policy_network();
+    utec::pong::PolicyNetwork policy(*network);
+    const size_t decisions = 1024;
+    vector<array<float, 5>> states(decisions);
+    for (size_t d = 0; d < decisions; ++d) {
+        for (size_t j = 0; j < 5; ++j) states[d][j] = float((d * 7 + j * 3) % 17) / 8.0f - 1.0f;
+    }
+
+    float sink = 0.0f;
+    Tensor<float, 2> input(1, 5);
+    double by_value = time_per_call([&] {
+        for (const auto& state : states) {
+            Tensor<float, 2> row(1, 5);
+            copy(state.begin(), state.end(), row.data());
+            sink += network->predict(row)(0, 0);
+        }
+    });
+    double batched = time_per_call([&] {
+        for (const auto& state : states) {
+            copy(state.begin(), state.end(), input.data());
+            sink += network->predict_batch(input)(0, 0);
+        }
+    });
+    double compiled = time_per_call([&] {
+        for (const auto& state : states) {
+            sink += policy.predict(state)[0];
+        }
+    });
+
+    cout << left << setw(34) << "NeuralNetwork::predict" << right << fixed << setprecision(1)
+         << setw(10) << by_value * 1e9 / decisions << " ns/decisión" << endl;
+    cout << left << setw(34) << "NeuralNetwork::predict_batch (1x5)" << right
+         << setw(10) << batched * 1e9 / decisions << " ns/decisión" << endl;
+    cout << left << setw(34) << "StaticNetwork::predict" << right
+         << setw(10) << compiled * 1e9 / decisions << " ns/decisión" << endl;
+    cout << "(checksum " << sink << ")" << endl << endl;
+}
+
+void bench_optimizers() {
+    cout << "=== Optimizadores: actualización de 1M parámetros ===" << endl;
+    {
+        // Referencia: el SGD anterior, elemento a elemento con operator()
+        Tensor<float, 2> w(1024, 1024), g(1024, 1024);
+        w.random_fill(-1.0f, 1.0f);
+        g.random_fill(-1.0f, 1.0f);
+        double naive = time_per_call([&] {
+            for (size_t i = 0; i < w.shape()[0]; ++i) {
+                for (size_t j = 0; j < w.shape()[1]; ++j) {
+                    w(i, j) -= 1e-6f * g(i, j);
+                }
+            }
+        });
+        cout << left << setw(22) << "sgd (operator())" << right << fixed << setprecision(3)
+             << setw(10) << naive * 1e9 / w.size() << " ns/parámetro" << endl;
+        for (const char* name : {"sgd", "momentum", "rmsprop", "adam"}) {
+            auto optimizer = make_optimizer<float>(name, 1e-6f);
+            double t = time_per_call([&] { optimizer->step(w.data(), g.data(), w.size()); });
+            cout << left << setw(22) << name << right << setw(10) << t * 1e9 / w.size() << " ns/parámetro" << endl;
+        }
+    }
+    cout << endl;
+
+    // Convergencia sobre partidas grabadas: mismos pesos iniciales y mismo
+    // dataset para todos; pérdida por época y tiempo hasta igualar la
+    // pérdida final de sgd tras TRAINING_EPOCHS * 2 épocas
+    utec::pong::TrainingSet data;
+    utec::pong::collect_training_games(utec::pong::Rng::default_seed, utec::pong::TRAINING_GAMES, data);
+    const string initial = "bench_optimizers_init.bin";
+    utec::pong::make_policy_network()->save(initial);
+
+    const int epochs = utec::pong::TRAINING_EPOCHS * 2;
+    cout << "=== Convergencia en " << data.size() << " muestras de Pong ("
+         << epochs << " épocas, batch 256) ===" << endl;
+    cout << left << setw(16) << "optimizador" << right << setw(10) << "lr"
+         << setw(13) << "época 10" << setw(13) << "época 25" << setw(12) << "final"
+         << setw(14) << "s/época" << setw(20) << "épocas a objetivo" << setw(15) << "s a objetivo" << endl;
+
+    float target = 0.0f;
+    for (auto [name, lr] : {pair{"sgd", 0.05f}, pair{"momentum", 0.005f}, pair{"rmsprop", 0.0005f}, pair{"adam", 0.001f}}) {
+        auto network = utec::pong::make_policy_network();
+        network->load(initial);
+        network->set_optimizer(name, lr);
+        network->set_num_threads(1);
+
+        vector<float> losses;
+        double seconds = 0.0;
+        for (int epoch = 0; epoch < epochs; ++epoch) {
+            auto start = chrono::steady_clock::now();
+            losses.push_back(network->train(data, 1, false));
+            seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        }
+        if (target == 0.0f) target = losses.back();  // sgd define el objetivo
+        int reached = int(find_if(losses.begin(), losses.end(), [&](float l) { return l <= target; }) - losses.begin()) + 1;
+
+        cout << left << setw(16) << name << right << setprecision(4) << setw(10) << lr
+             << setprecision(5) << setw(12) << losses[9] << setw(12) << losses[24] << setw(12) << losses.back()
+             << setprecision(4) << setw(14) << seconds / epochs;
+        if (reached <= epochs) {
+            cout << setw(19) << reached << setw(15) << seconds / epochs * reached << endl;
+        } else {
+            cout << setw(19) << "-" << setw(15) << "-" << endl;
+        }
+    }
+    remove(initial.c_str());
+    cout << endl;
+}
+
+void bench_self_play() {
+    cout << "=== Partidas de entrenamiento en paralelo (pong/self_play.h) ===" << endl;
+    cout << left << setw(10) << "hilos" << right << setw(16) << "partidas/s" << setw(12) << "x" << endl;
+
+    const int matches = 2000;
+    size_t max_threads = max(1u, thread::hardware_concurrency());
+    double base = 0.0;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        utec::pong::TrainingSet data;
+        auto stats = utec::pong::run_self_play(1, matches, threads, data);
+        if (threads == 1) base = stats.games_per_second();
+        cout << left << setw(10) << threads << right << fixed << setprecision(0)
+             << setw(16) << stats.games_per_second()
+             << setw(12) << setprecision(2) << stats.games_per_second() / base << endl;
+    }
+    cout << endl;
+}
+
+void bench_evolution() {
+    cout << "=== Estrategias evolutivas: rollouts en paralelo (pong/evolution.h) ===" << endl;
+    cout << left << setw(10) << "hilos" << right << setw(16) << "generaciones/s"
+         << setw(14) << "rollouts/s" << setw(12) << "x" << endl;
+
+    // Mismos pesos iniciales y semilla para cada número de hilos: se juegan
+    // exactamente las mismas partidas
+    auto initial = utec::pong::make_policy_network()->get_parameters();
+    const int generations = 5;
+    size_t max_threads = max(1u, thread::hardware_concurrency());
+    double base = 0.0;
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        auto network = utec::pong::make_policy_network();
+        network->set_parameters(initial);
+        utec::pong::EvolutionConfig config;
+        config.seed = 1;
+        config.num_threads = threads;
+        utec::pong::EvolutionStrategies es(*network, config);
+        double seconds = 0.0;
+        size_t rollouts = 0;
+        for (int g = 0; g < generations; ++g) {
+            auto stats = es.step();
+            seconds += stats.seconds;
+            rollouts += stats.rollouts;
+        }
+        double per_second = generations / seconds;
+        if (threads == 1) base = per_second;
+        cout << left << setw(10) << threads << right << fixed << setprecision(2)
+             << setw(16) << per_second << setw(14) << setprecision(0) << rollouts / seconds
+             << setw(12) << setprecision(2) << per_second / base << endl;
+    }
+    cout << endl;
+}
+
+// Cola SPSC de user-018 (índices contiguos, sin caché del otro índice),
+// conservada como referencia para comparar
+template<typename T>
+class UnpaddedQueue {
+    vector<T> slots_;
+    size_t mask_;
+    atomic<size_t> head_{0};
+    atomic<size_t> tail_{0};
+
+public:
+    explicit UnpaddedQueue(size_t capacity) : slots_(capacity), mask_(capacity - 1) {}
+
+    bool try_push(const T& value) {
+        size_t tail = tail_.load(memory_order_relaxed);
+        if (tail - head_.load(memory_order_acquire) == slots_.size()) return false;
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        size_t head = head_.load(memory_order_relaxed);
+        if (head == tail_.load(memory_order_acquire)) return false;
+        value = slots_[head & mask_];
+        head_.store(head + 1, memory_order_release);
+        return true;
+    }
+};
+
+// Alternativa ingenua con lock
+template<typename T>
+class MutexQueue {
+    mutex mutex_;
+    deque<T> items_;
+    size_t capacity_;
+
+public:
+    explicit MutexQueue(size_t capacity) : capacity_(capacity) {}
+
+    bool try_push(const T& value) {
+        lock_guard<mutex> lock(mutex_);
+        if (items_.size() == capacity_) return false;
+        items_.push_back(value);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        lock_guard<mutex> lock(mutex_);
+        if (items_.empty()) return false;
+        value = items_.front();
+        items_.pop_front();
+        return true;
+    }
+};
+
+// Muestras/s en un hilo: se encola un lote (los fotogramas) y se vacía
+template<typename Queue>
+double queue_single_thread(size_t batch) {
+    Queue queue(batch);
+    utec::pong::Sample sample{{0.1f, 0.2f, 0.3f, 0.4f, 0.5f}, 0.0f}, out;
+    float sink = 0.0f;
+    double seconds = time_per_call([&] {
+        for (size_t i = 0; i < batch; ++i) {
+            sample.action = float(i);
+            queue.try_push(sample);
+        }
+        while (queue.try_pop(out)) sink += out.action;
+    });
+    if (sink < 0.0f) cout << sink;
+    return batch / seconds;
+}
+
+// Muestras/s entre un productor y un consumidor en hilos distintos
+template<typename Queue>
+double queue_two_threads(size_t total, size_t capacity) {
+    Queue queue(capacity);
+    double best = 0.0;
+    for (int run = 0; run < 3; ++run) {
+        auto start = chrono::steady_clock::now();
+        thread producer([&] {
+            utec::pong::Sample sample{{0.1f, 0.2f, 0.3f, 0.4f, 0.5f}, 0.0f};
+            for (size_t i = 0; i < total; ++i) {
+                sample.action = float(i);
+                while (!queue.try_push(sample)) this_thread::yield();
+            }
+        });
+        utec::pong::Sample out;
+        size_t received = 0;
+        while (received < total) {
+            if (queue.try_pop(out)) {
+                ++received;
+            } else {
+                this_thread::yield();
+            }
+        }
+        producer.join();
+        best = max(best, total / chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+void bench_sample_queue() {
+    cout << "=== Cola de muestras juego -> entrenador (nn/spsc_queue.h) ===" << endl;
+    cout << "Registro de " << sizeof(utec::pong::Sample) << " bytes, "
+         << thread::hardware_concurrency() << " núcleo(s)" << endl;
+    cout << left << setw(24) << "cola" << right
+         << setw(22) << "1 hilo [muestras/s]" << setw(22) << "2 hilos [muestras/s]" << endl;
+
+    using utec::pong::Sample;
+    const size_t batch = 4096, total = size_t(1) << 21;
+    auto row = [](const char* name, double single, double two) {
+        cout << left << setw(24) << name << right << scientific << setprecision(2)
+             << setw(22) << single << setw(22) << two << endl;
+    };
+    row("SpscQueue", queue_single_thread<utec::parallel::SpscQueue<Sample>>(batch),
+        queue_two_threads<utec::parallel::SpscQueue<Sample>>(total, batch));
+    row("sin padding (user-018)", queue_single_thread<UnpaddedQueue<Sample>>(batch),
+        queue_two_threads<UnpaddedQueue<Sample>>(total, batch));
+    row("mutex + deque", queue_single_thread<MutexQueue<Sample>>(batch),
+        queue_two_threads<MutexQueue<Sample>>(total, batch));
+
+    // Vaciado por lotes, como el entrenador
+    utec::parallel::SpscQueue<Sample> queue(batch);
+    Sample sample{{0.1f, 0.2f, 0.3f, 0.4f, 0.5f}, 0.0f};
+    float sink = 0.0f;
+    double seconds = time_per_call([&] {
+        for (size_t i = 0; i < batch; ++i) queue.try_push(sample);
+        queue.consume([&sink](const Sample& s) { sink += s.action; });
+    });
+    if (sink < 0.0f) cout << sink;
+    cout << left << setw(24) << "SpscQueue + consume()" << right << scientific << setprecision(2)
+         << setw(22) << batch / seconds << fixed << endl << endl;
+}
+
+void bench_vector_env() {
+    cout << "=== Simulación: pong::step escalar vs VectorEnv (SoA) ===" << endl;
+    cout << left << setw(10) << "partidas" << right
+         << setw(20) << "escalar [pasos/s]" << setw(20) << "SoA [pasos/s]" << setw(10) << "x" << endl;
+
+    const int frames = 64;
+    for (size_t games : {1, 64, 1024, 16384}) {
+        // Acciones fijas para ambos caminos: sólo se mide la física
+        vector<int> player_dir(games), ai_dir(games);
+        for (size_t g = 0; g < games; ++g) {
+            player_dir[g] = int(g % 3) - 1;
+            ai_dir[g] = int((g / 3) % 3) - 1;
+        }
+
+        vector<utec::pong::Game> scalar_games;
+        for (size_t g = 0; g < games; ++g) scalar_games.emplace_back(uint32_t(g));
+        double scalar = time_per_call([&] {
+            for (int f = 0; f < frames; ++f) {
+                for (size_t g = 0; g < games; ++g) {
+                    int dir = ai_dir[g];
+                    scalar_games[g].step(player_dir[g], [dir](utec::pong::Paddle& ai, const utec::pong::Ball&) {
+                        ai.move(dir);
+                    });
+                    if (scalar_games[g].over()) scalar_games[g].reset();
+                }
+            }
+        });
+
+        utec::pong::VectorEnv env(games, 1);
+        double soa = time_per_call([&] {
+            for (int f = 0; f < frames; ++f) {
+                env.step(player_dir.data(), ai_dir.data());
+                env.reset_finished();
+            }
+        });
+
+        double steps = double(games) * frames;
+        cout << left << setw(10) << games << right << scientific << setprecision(2)
+             << setw(20) << steps / scalar << setw(20) << steps / soa
+             << fixed << setw(10) << scalar / soa << endl;
+    }
+    cout << endl;
+}
+
+void bench_batched_inference() {
+    cout << "=== Inferencia de la política: una fila por paddle vs por lotes ===" << endl;
+    cout << left << setw(10) << "paddles" << right
+         << setw(20) << "por fila [ns/dec]" << setw(20) << "lote [ns/dec]" << setw(10) << "x" << endl;
+
+    auto network = utec::pong::make_policy_network();
+    for (size_t paddles : {1, 64, 1024, 16384}) {
+        utec::pong::VectorEnv env(paddles, 1);
+        vector<float> states(paddles * 5);
+        env.observations(states.data());
+
+        // Camino de AIPaddle::UpdateWithNN: un tensor 1x5 y un predict por paddle
+        double per_row = time_per_call([&] {
+            for (size_t g = 0; g < paddles; ++g) {
+                Tensor<float, 2> input(1, 5);
+                for (int i = 0; i < 5; ++i) input(0, i) = states[g * 5 + i];
+                auto prediction = network->predict(input);
+                (void)utec::pong::policy_direction(prediction(0, 0), 0.1f, 6);
+            }
+        });
+
+        utec::pong::BatchedPolicy policy(*network);
+        double batched = time_per_call([&] { policy.act(env); });
+
+        cout << left << setw(10) << paddles << right << fixed << setprecision(1)
+             << setw(20) << per_row * 1e9 / paddles << setw(20) << batched * 1e9 / paddles
+             << setprecision(2) << setw(10) << per_row / batched << endl;
+    }
+    cout << endl;
+}
+
+void bench_quantized_inference() {
+    cout << "=== Política cuantizada: acuerdo con fp32 y decisiones/s (lote 1024) ===" << endl;
+
+    // Política entrenada con 20 partidas grabadas (que también sirven de
+    // calibración); el acuerdo se mide sobre 5 partidas con otra semilla
+    utec::pong::TrainingSet recorded, held_out;
+    utec::pong::collect_training_games(1, 20, recorded);
+    utec::pong::collect_training_games(2, 5, held_out);
+    auto network = utec::pong::make_policy_network();
+    network->train(recorded, 30, false);
+
+    Tensor<float, 2> states(held_out.size(), 5);
+    for (size_t r = 0; r < held_out.size(); ++r) copy_n(held_out.input(r), 5, states.data() + r * 5);
+    const Tensor<float, 2> reference = network->predict_batch(states);
+
+    const size_t batch = 1024;
+    Tensor<float, 2> input(batch, 5);
+    copy_n(states.data(), input.size(), input.data());
+    float sink = 0.0f;
+    double fp32_seconds = time_per_call([&] { sink += network->predict_batch(input)(0, 0); });
+
+    cout << left << setw(18) << "precisión" << right << setw(12) << "pesos [B]" << setw(14) << "error máx"
+         << setw(12) << "acuerdo" << setw(16) << "decisiones/s" << setw(8) << "x" << endl;
+    auto report = [&](const string& name, size_t bytes, float error, double agreement, double seconds) {
+        cout << left << setw(18) << name << right << setw(12) << bytes << scientific << setprecision(2)
+             << setw(14) << error << fixed << setprecision(2) << setw(11) << 100.0 * agreement << "%"
+             << scientific << setw(16) << batch / seconds << fixed << setw(8) << fp32_seconds / seconds << endl;
+    };
+    report("NeuralNetwork", QuantizedNetwork(*network, Precision::fp32).weight_bytes(), 0.0f, 1.0, fp32_seconds);
+
+    auto evaluate = [&](const string& name, QuantizedNetwork& quantized) {
+        const auto& actions = quantized.predict_batch(states);
+        float error = 0.0f;
+        size_t agree = 0;
+        for (size_t r = 0; r < held_out.size(); ++r) {
+            error = max(error, fabs(actions(r, 0) - reference(r, 0)));
+            agree += utec::pong::policy_direction(actions(r, 0), 0.1f, 6) ==
+                     utec::pong::policy_direction(reference(r, 0), 0.1f, 6);
+        }
+        double seconds = time_per_call([&] { sink += quantized.predict_batch(input)(0, 0); });
+        report(name, quantized.weight_bytes(), error, double(agree) / held_out.size(), seconds);
+    };
+    for (Precision precision : {Precision::fp32, Precision::bf16, Precision::fp16, Precision::int8}) {
+        QuantizedNetwork quantized(*network, precision, recorded);
+        if (precision != Precision::int8) {
+            evaluate(precision_name(precision), quantized);
+            continue;
+        }
+        for (gemm::Isa isa : {gemm::Isa::scalar, gemm::Isa::avx2, gemm::Isa::avx512}) {
+            gemm::force_isa(isa);
+            if (gemm::active_isa() != isa) continue;
+            evaluate(string("int8 ") + (isa == gemm::Isa::avx512 ? "vnni" : gemm::isa_name(isa)), quantized);
+        }
+        gemm::force_isa(gemm::detected_isa());
+    }
+    cout << "(" << held_out.size() << " estados de prueba, checksum " << sink << ")" << endl << endl;
+}
+
+// Suite de regresión: casos fijos con nombres estables, para seguir su
+// evolución en el JSON
+void run_suite(utec::bench::Suite& suite) {
+    using utec::bench::do_not_optimize;
+    cout << "=== Suite de regresión ===" << endl;
+
+    // Tensor::matmul con las formas de las capas de la política (batch 256
+    // del entrenamiento y una fila al jugar)
+    const size_t shapes[][3] = {{256, 5, 16}, {256, 16, 16}, {256, 16, 1}, {1, 5, 16}};
+    for (const auto& shape : shapes) {
+        Tensor<float, 2> a(shape[0], shape[1]), b(shape[1], shape[2]);
+        a.random_fill(-1.0f, 1.0f);
+        b.random_fill(-1.0f, 1.0f);
+        string name = "tensor/matmul/" + to_string(shape[0]) + "x" + to_string(shape[1]) + "x" + to_string(shape[2]);
+        suite.run(name, double(shape[0]), "filas", [&] {
+            auto c = a.matmul(b);
+            do_not_optimize(c);
+        });
+    }
+
+    Tensor<float, 2> big(256, 256);
+    big.random_fill(-1.0f, 1.0f);
+    suite.run("tensor/apply/256x256", double(big.size()), "elementos", [&] {
+        Tensor<float, 2> r = big.apply([](float x) { return x * x + 1.0f; });
+        do_not_optimize(r);
+    });
+    for (size_t rows : {256, 1024}) {
+        Tensor<float, 2> t(rows, rows == 256 ? 16 : 1024);
+        t.random_fill(-1.0f, 1.0f);
+        string name = "tensor/transpose/" + to_string(t.shape()[0]) + "x" + to_string(t.shape()[1]);
+        suite.run(name, double(t.size()), "elementos", [&] {
+            auto r = t.transpose();
+            do_not_optimize(r);
+        });
+    }
+
+    // DenseLayer 16 -> 16 con un mini-batch de 256
+    DenseLayer<float> dense(16, 16);
+    Tensor<float, 2> input(256, 16), grad(256, 16);
+    input.random_fill(-1.0f, 1.0f);
+    grad.random_fill(-1.0f, 1.0f);
+    suite.run("dense/forward/256x16x16", 256.0, "filas", [&] {
+        auto out = dense.forward(input);
+        do_not_optimize(out);
+    });
+    dense.forward(input);
+    suite.run("dense/backward/256x16x16", 256.0, "filas", [&] {
+        auto out = dense.backward(grad);
+        do_not_optimize(out);
+    });
+
+    // Una época de la política sobre 10 partidas grabadas (batch 256)
+    utec::pong::TrainingSet data;
+    utec::pong::collect_training_games(1, 10, data);
+    for (size_t threads : {size_t(1), size_t(0)}) {
+        auto network = utec::pong::make_policy_network();
+        network->set_num_threads(threads);
+        string name = threads == 1 ? "network/train_epoch/1thread" : "network/train_epoch/all_threads";
+        suite.run(name, double(data.size()), "muestras", [&] {
+            float loss = network->train(data, 1, false);
+            do_not_optimize(loss);
+        });
+    }
+
+    // Latencia de una decisión (una fila)
+    auto network = utec::pong::make_policy_network();
+    utec::pong::PolicyNetwork policy(*network);
+    Tensor<float, 2> state(1, 5);
+    state.random_fill(-1.0f, 1.0f);
+    array<float, 5> state_array;
+    copy(state.data(), state.data() + 5, state_array.begin());
+    suite.run("network/predict/1x5", 1.0, "predicciones", [&] {
+        auto out = network->predict(state);
+        do_not_optimize(out);
+    });
+    suite.run("static_network/predict/1x5", 1.0, "predicciones", [&] {
+        auto out = policy.predict(state_array);
+        do_not_optimize(out);
+    });
+
+    // Inferencia por lotes con pesos fp32, bf16 e int8
+    Tensor<float, 2> states(1024, 5);
+    states.random_fill(-1.0f, 1.0f);
+    for (Precision precision : {Precision::fp32, Precision::bf16, Precision::int8}) {
+        QuantizedNetwork quantized(*network, precision, data);
+        suite.run(string("quantized/predict/") + precision_name(precision) + "/1024x5", 1024.0, "predicciones", [&] {
+            const auto& out = quantized.predict_batch(states);
+            do_not_optimize(out);
+        });
+    }
+
+    // Simulación: la partida del modo entrenamiento y VectorEnv
+    utec::pong::Game game(1);
+    game.reset();
+    const int frames = 1024;
+    suite.run("simulation/game_step", double(frames), "pasos", [&] {
+        for (int f = 0; f < frames; ++f) {
+            game.step(0, [](utec::pong::Paddle& ai, const utec::pong::Ball& ball) {
+                utec::pong::scripted_policy(ai, ball);
+            });
+            if (game.over()) game.reset();
+        }
+    });
+    const size_t games = 1024;
+    utec::pong::VectorEnv env(games, 1);
+    vector<int> player_dir(games), ai_dir(games);
+    for (size_t g = 0; g < games; ++g) {
+        player_dir[g] = int(g % 3) - 1;
+        ai_dir[g] = int((g / 3) % 3) - 1;
+    }
+    suite.run("simulation/vector_env_step/1024", double(games), "pasos", [&] {
+        env.step(player_dir.data(), ai_dir.data());
+        env.reset_finished();
+    });
+
+    // Un paso de DQN: acción por lotes en 64 partidas, 4 fotogramas y 4
+    // mini-batches (pasado el calentamiento del buffer)
+    utec::pong::DQNConfig dqn_config;
+    dqn_config.seed = 1;
+    utec::pong::DQNTrainer dqn(dqn_config);
+    if (suite.selected("dqn/step/64")) dqn.run(dqn_config.warmup / dqn_config.envs + 1);
+    suite.run("dqn/step/64", double(dqn_config.envs), "transiciones", [&] {
+        dqn.run(1);
+    });
+
+    suite.print(cout);
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    bool suite_only = false;
+    string json_path;
+    utec::bench::Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--suite") == 0) {
+            suite_only = true;
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            options.samples = stoul(argv[++i]);
+        } else {
+            cerr << "Opción desconocida: " << argv[i] << endl;
+            return 1;
+        }
+    }
+
+    cout << "=== BENCHMARKS PONGSASOS ===" << endl << endl;
+    utec::bench::Suite suite(options);
+    run_suite(suite);
+    if (!json_path.empty()) {
+        ofstream out(json_path);
+        suite.write_json(out, {{"compiler", __VERSION__},
+                               {"isa", gemm::isa_name(gemm::detected_isa())},
+                               {"hardware_threads", to_string(thread::hardware_concurrency())}});
+        if (!out) {
+            cerr << "No se pudo escribir " << json_path << endl;
+            return 1;
+        }
+        cout << "Resultados en " << json_path << endl << endl;
+    }
+    if (suite_only) return 0;
+
+    bench_matmul();
+    bench_tensor_expressions();
+    bench_dense_backward();
+    bench_activations();
+    bench_layer_fusion();
+    bench_optimizers();
+    bench_self_play();
+    bench_evolution();
+    bench_sample_queue();
+    bench_vector_env();
+    bench_batched_inference();
+    bench_quantized_inference();
+    bench_policy_decision();
+    return 0;
+}
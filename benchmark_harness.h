@@ -0,0 +1,172 @@
+#ifndef BENCHMARK_HARNESS_H
+#define BENCHMARK_HARNESS_H
+
+// Arnés mínimo para la suite de regresión de pongsasos_bench, al estilo de
+// Google Benchmark: cada caso se calienta, se calibra cuántas llamadas
+// caben en una muestra de ~sample_seconds y se toman `samples` muestras.
+// De cada caso se reporta el tiempo por llamada (mínimo, mediana, media,
+// desviación, máximo) y el throughput en unidades por segundo (filas,
+// elementos, pasos...). Los resultados se pueden escribir como JSON para
+// comparar entre commits.
+//
+// En máquinas ruidosas conviene comparar el mínimo: la mediana refleja
+// mejor el caso típico pero sube con cualquier interrupción.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <ctime>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace utec {
+namespace bench {
+
+// Impide que el compilador elimine un cálculo cuyo resultado no se usa
+template<typename T>
+inline void do_not_optimize(T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    volatile auto sink = &value;
+    (void)sink;
+#endif
+}
+
+struct Options {
+    double warmup_seconds = 0.05;
+    double sample_seconds = 0.01;
+    size_t samples = 15;
+    std::string filter;   // sólo los casos cuyo nombre contiene filter
+};
+
+struct Result {
+    std::string name;
+    std::string unit;          // qué cuenta items (filas, pasos...)
+    double items = 0.0;        // unidades de trabajo por llamada
+    size_t iterations = 0;     // llamadas por muestra
+    size_t samples = 0;
+    double min_ns = 0.0, median_ns = 0.0, mean_ns = 0.0, stddev_ns = 0.0, max_ns = 0.0;
+
+    double items_per_second() const { return items * 1e9 / median_ns; }
+};
+
+class Suite {
+private:
+    Options options_;
+    std::vector<Result> results_;
+
+    static std::string escape(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+public:
+    explicit Suite(Options options = {}) : options_(std::move(options)) {}
+
+    bool selected(const std::string& name) const {
+        return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+    }
+
+    // Mide func(), que hace `items` unidades de `unit` por llamada
+    template<typename Func>
+    void run(const std::string& name, double items, const std::string& unit, Func&& func) {
+        if (!selected(name)) return;
+        using clock = std::chrono::steady_clock;
+
+        // Calentamiento, que además estima el costo de una llamada
+        size_t calls = 0;
+        auto start = clock::now();
+        double elapsed = 0.0;
+        do {
+            func();
+            ++calls;
+            elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        } while (elapsed < options_.warmup_seconds);
+
+        Result result;
+        result.name = name;
+        result.unit = unit;
+        result.items = items;
+        result.iterations = std::max<size_t>(1, size_t(options_.sample_seconds * calls / elapsed));
+        result.samples = std::max<size_t>(1, options_.samples);
+
+        std::vector<double> ns(result.samples);
+        for (auto& sample : ns) {
+            auto begin = clock::now();
+            for (size_t i = 0; i < result.iterations; ++i) func();
+            sample = std::chrono::duration<double, std::nano>(clock::now() - begin).count() / result.iterations;
+        }
+
+        std::sort(ns.begin(), ns.end());
+        result.min_ns = ns.front();
+        result.max_ns = ns.back();
+        size_t mid = ns.size() / 2;
+        result.median_ns = ns.size() % 2 ? ns[mid] : 0.5 * (ns[mid - 1] + ns[mid]);
+        double sum = 0.0;
+        for (double x : ns) sum += x;
+        result.mean_ns = sum / ns.size();
+        double var = 0.0;
+        for (double x : ns) var += (x - result.mean_ns) * (x - result.mean_ns);
+        result.stddev_ns = ns.size() > 1 ? std::sqrt(var / (ns.size() - 1)) : 0.0;
+
+        results_.push_back(result);
+    }
+
+    const std::vector<Result>& results() const { return results_; }
+
+    void print(std::ostream& out) const {
+        out << std::left << std::setw(34) << "caso" << std::right
+            << std::setw(14) << "min [ns]" << std::setw(14) << "mediana [ns]"
+            << std::setw(10) << "desv %" << std::setw(14) << "unidades/s" << "  unidad" << std::endl;
+        for (const auto& r : results_) {
+            out << std::left << std::setw(34) << r.name << std::right << std::fixed << std::setprecision(1)
+                << std::setw(14) << r.min_ns << std::setw(14) << r.median_ns
+                << std::setw(10) << 100.0 * r.stddev_ns / r.mean_ns
+                << std::scientific << std::setprecision(3) << std::setw(14) << r.items_per_second()
+                << "  " << r.unit << std::fixed << std::endl;
+        }
+    }
+
+    // context: pares clave/valor extra (compilador, ISA, núcleos...)
+    void write_json(std::ostream& out, const std::vector<std::pair<std::string, std::string>>& context) const {
+        char date[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+        out << "{\n  \"context\": {\n    \"date\": \"" << date << "\"";
+        for (const auto& [key, value] : context) {
+            out << ",\n    \"" << escape(key) << "\": \"" << escape(value) << "\"";
+        }
+        out << "\n  },\n  \"benchmarks\": [";
+        out << std::setprecision(6);
+        for (size_t i = 0; i < results_.size(); ++i) {
+            const auto& r = results_[i];
+            out << (i ? "," : "") << "\n    {\"name\": \"" << escape(r.name) << "\""
+                << ", \"unit\": \"" << escape(r.unit) << "\""
+                << ", \"items_per_call\": " << r.items
+                << ", \"iterations\": " << r.iterations
+                << ", \"samples\": " << r.samples
+                << ", \"min_ns\": " << r.min_ns
+                << ", \"median_ns\": " << r.median_ns
+                << ", \"mean_ns\": " << r.mean_ns
+                << ", \"stddev_ns\": " << r.stddev_ns
+                << ", \"max_ns\": " << r.max_ns
+                << ", \"items_per_second\": " << r.items_per_second() << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+};
+
+} // namespace bench
+} // namespace utec
+
+#endif // BENCHMARK_HARNESS_H
@@ -2,9 +2,13 @@
 #include <raylib.h>
 #include "nn/network.h"
 #include "nn/tensor.h"
+#include "pong/training.h"
+#include "pong/background_trainer.h"
+#include "nn/profiler.h"
 #include <memory>
 #include <fstream>
 #include <random>
+#include <chrono>
 
 using namespace std;
 using namespace utec::neural_network;
@@ -14,125 +18,69 @@ Color blue = Color{60, 110, 155};
 Color dark_blue = Color{25, 30, 65};
 Color light_blue = Color{110, 150, 185};
 
-const int screen_width = 1200;
-const int screen_height = 800;
-int player_score = 0;
-int ai_score = 0;
+namespace pong = utec::pong;
+
+const int screen_width = pong::screen_width;
+const int screen_height = pong::screen_height;
+pong::Score score;
+pong::Rng rng;
+
+// Semilla de las partidas de entrenamiento: con la misma semilla el modo
+// ventana y pong_train recolectan exactamente el mismo dataset
+uint32_t training_seed = pong::Rng::default_seed;
 
 // Configuración de la red neuronal
-const int TRAINING_GAMES = 100;
-const int TRAINING_EPOCHS = 50;
+const int TRAINING_GAMES = pong::TRAINING_GAMES;
+const int TRAINING_EPOCHS = pong::TRAINING_EPOCHS;
+const string MODEL_FILE = pong::MODEL_FILE;
 bool is_training = false;
 int games_played = 0;
+bool show_profiler = false;
+const string TRACE_FILE = "pongsasos_trace.json";
 
-class Ball {
+class Ball : public pong::Ball {
 public:
-    float x, y;
-    int speed_x, speed_y;
-    int radius;
-
     void Draw() {
         DrawCircle(x, y, radius, WHITE);
     }
-
-    void Update() {
-        x += speed_x;
-        y += speed_y;
-
-        if (y + radius >= GetScreenHeight() || y - radius <= 0) {
-            speed_y *= -1;
-        }
-
-        if (x + radius >= GetScreenWidth()) {
-            ai_score++;
-            Reset();
-        }
-        if (x - radius <= 0) {
-            player_score++;
-            Reset();
-        }
-    }
-
-    void Reset() {
-        x = GetScreenWidth()/2;
-        y = GetScreenHeight()/2;
-        int speed_choices[2] = {-1, 1};
-        speed_x *= speed_choices[GetRandomValue(0, 1)];
-        speed_y *= speed_choices[GetRandomValue(0, 1)];
-    }
-
-    // Función para obtener el estado normalizado para la IA
-    vector<float> GetNormalizedState(float paddle_y) const {
-        vector<float> state;
-        state.push_back(x / float(screen_width));           // Posición X normalizada
-        state.push_back(y / float(screen_height));          // Posición Y normalizada
-        state.push_back(speed_x / 10.0f);                   // Velocidad X normalizada
-        state.push_back(speed_y / 10.0f);                   // Velocidad Y normalizada
-        state.push_back(paddle_y / float(screen_height));   // Posición paddle normalizada
-        return state;
-    }
 };
 
-class Paddle {
-protected:
-    void LimitMovement() {
-        if (y <= 0) {
-            y = 0;
-        }
-        if (y + height >= GetScreenHeight()) {
-            y = GetScreenHeight() - height;
-        }
-    }
-
+class Paddle : public pong::Paddle {
 public:
-    float x, y;
-    float width, height;
-    int speed;
-
     void Draw() {
         DrawRectangle(x, y, width, height, WHITE);
     }
 
-    void Update() {
+    // Dirección pedida por el teclado: -1 sube, +1 baja
+    int InputDirection() const {
         if (IsKeyDown(KEY_UP)) {
-            y -= speed;
+            return -1;
         } else if (IsKeyDown(KEY_DOWN)) {
-            y += speed;
+            return 1;
         }
-        LimitMovement();
+        return 0;
     }
 };
 
 class AIPaddle : public Paddle {
 private:
-    unique_ptr<NeuralNetwork<float>> network;
-    vector<vector<float>> training_data_X;
-    vector<vector<float>> training_data_y;
+    // Dueño de la red (5 -> 16 -> 16 -> 1, tanh): la entrena en otro hilo y
+    // publica la política que se usa en cada fotograma
+    pong::BackgroundTrainer trainer;
+    uint64_t reported_save = 0;
+    bool reported_failure = false;
 
 public:
     float last_ball_x = 0;
     float action_threshold = 0.1f;  // Umbral para evitar micro-movimientos
-    AIPaddle() {
-        // Crear la red neuronal
-        network = make_unique<NeuralNetwork<float>>();
-
-        // Arquitectura: 5 inputs -> 16 hidden -> 16 hidden -> 1 output (más neuronas)
-        network->add_dense_layer(5, 16);
-        network->add_activation("tanh");
-        network->add_dense_layer(16, 16);
-        network->add_activation("tanh");
-        network->add_dense_layer(16, 1);
-        network->add_activation("tanh");
-
-        // Configurar optimizador con learning rate más alto
-        network->set_optimizer("sgd", 0.05f);
-        network->set_loss_function("mse");
+    AIPaddle() : trainer(pong::make_policy_network()) {
+        trainer.set_save_path(MODEL_FILE);
 
         cout << "Red neuronal creada con éxito!" << endl;
-        network->print_architecture();
+        trainer.network().print_architecture();
     }
 
-    void Update(const Ball& ball) {
+    void Update(const pong::Ball& ball) {
         if (is_training) {
             // Durante el entrenamiento, usar estrategia simple para generar datos
             UpdateTraining(ball);
@@ -140,108 +88,73 @@ public:
             // Durante el juego, usar la red neuronal entrenada
             UpdateWithNN(ball);
         }
-
-        LimitMovement();
     }
 
-    void UpdateTraining(const Ball& ball) {
-        // Estrategia mejorada para generar datos de entrenamiento
-        float ball_center_y = ball.y;
-        float paddle_center_y = y + height/2;
-
-        // Calcular donde debería estar el paddle
-        float target_y = ball_center_y - height/2;
-
-        // Calcular la diferencia
-        float diff_y = target_y - y;
-
-        // Normalizar la acción entre -1 y 1
-        float target_action = 0.0f;
-        if (abs(diff_y) > 5.0f) {  // Solo moverse si la diferencia es significativa
-            target_action = std::max(-1.0f, std::min(1.0f, diff_y / (float)speed));
-        }
-
-        // Almacenar datos de entrenamiento
-        vector<float> input_data = ball.GetNormalizedState(y);
-        training_data_X.push_back(input_data);
-        training_data_y.push_back({target_action});
-
-        // Aplicar la acción de entrenamiento
-        if (abs(diff_y) > 10.0f) {  // Umbral para evitar micro-movimientos
-            if (diff_y > 0) {
-                y += speed;
-            } else {
-                y -= speed;
-            }
-        }
+    void UpdateTraining(const pong::Ball& ball) {
+        // Encola el estado y la acción de la política programada para el
+        // entrenador (sin bloquear ni asignar memoria)
+        pong::record_scripted_move(*this, ball, trainer);
     }
 
-    void UpdateWithNN(const Ball& ball) {
-        // Crear tensor de entrada
-        vector<float> input_data = ball.GetNormalizedState(y);
-        Tensor<float, 2> input_tensor(1, 5);
-
-        for (int i = 0; i < 5; i++) {
-            input_tensor(0, i) = input_data[i];
-        }
+    void UpdateWithNN(const pong::Ball& ball) {
+        PROFILE_ZONE("AIPaddle::UpdateWithNN");
+        // Última política publicada por el entrenador: red de tamaño fijo,
+        // sin memoria dinámica ni llamadas virtuales
+        float action = trainer.predict(ball.normalized_state(y));
 
-        // Predecir acción
-        auto prediction = network->predict(input_tensor);
-        float action = prediction(0, 0);
+        // Aplicar umbral y movimiento discreto para evitar titubeos
+        move(pong::policy_direction(action, action_threshold, speed));
+    }
 
-        // Aplicar umbral para evitar micro-movimientos
-        if (abs(action) > action_threshold) {
-            // Escalar la acción de manera más agresiva
-            float movement = action * speed * 1.5f;  // Multiplicador para movimiento más rápido
+    // Nueva sesión de recolección: el entrenador descarta las muestras de
+    // la anterior y sigue mejorando la misma red
+    void StartTrainingSession() {
+        trainer.begin_session();
+    }
 
-            // Aplicar movimiento discreto para evitar titubeos
-            if (movement > 2.0f) {
-                y += speed;
-            } else if (movement < -2.0f) {
-                y -= speed;
-            }
+    // El entrenador sigue TRAINING_EPOCHS * 2 épocas después de la última
+    // muestra y guarda el modelo; aquí sólo se informa, sin bloquear
+    void FinishTrainingSession() {
+        auto stats = trainer.stats();
+        cout << "Recolección terminada con " << stats.samples << " ejemplos";
+        if (stats.dropped > 0) {
+            cout << " (" << stats.dropped << " descartados con la cola llena)";
         }
+        cout << "; la red sigue entrenando en segundo plano..." << endl;
     }
 
-    void TrainNetwork() {
-        if (training_data_X.empty()) {
-            cout << "No hay datos de entrenamiento!" << endl;
-            return;
+    // Se llama en cada fotograma: informa cuando el entrenador guardó
+    void ReportTrainer() {
+        auto stats = trainer.stats();
+        if (stats.saved_version != reported_save) {
+            reported_save = stats.saved_version;
+            cout << "Entrenamiento completado! " << stats.epochs << " épocas, loss " << stats.loss
+                 << " (checksum " << hex << stats.checksum << dec << ")" << endl;
+            cout << "Modelo guardado en " << MODEL_FILE << endl;
         }
-
-        cout << "Entrenando red neuronal con " << training_data_X.size() << " ejemplos..." << endl;
-
-        // Convertir datos a tensores
-        Tensor<float, 2> X(training_data_X.size(), 5);
-        Tensor<float, 2> y(training_data_y.size(), 1);
-
-        for (size_t i = 0; i < training_data_X.size(); i++) {
-            for (int j = 0; j < 5; j++) {
-                X(i, j) = training_data_X[i][j];
-            }
-            y(i, 0) = training_data_y[i][0];
+        if (stats.save_failed && !reported_failure) {
+            cout << "No se pudo guardar el modelo en " << MODEL_FILE << endl;
         }
-
-        // Entrenar la red con más épocas
-        network->train(X, y, TRAINING_EPOCHS * 2, true);
-
-        cout << "Entrenamiento completado!" << endl;
-
-        // Limpiar datos de entrenamiento
-        training_data_X.clear();
-        training_data_y.clear();
+        reported_failure = stats.save_failed;
     }
 
-    void SaveModel(const string& filename) {
-        // Implementación básica para guardar el modelo
-        // En un proyecto real, guardarías los pesos de la red
-        cout << "Modelo guardado en " << filename << endl;
+    pong::BackgroundTrainer::Stats TrainerStats() const {
+        return trainer.stats();
     }
 
-    void LoadModel(const string& filename) {
-        // Implementación básica para cargar el modelo
-        // En un proyecto real, cargarías los pesos de la red
-        cout << "Modelo cargado desde " << filename << endl;
+    // Devuelve true si se cargó un modelo entrenado
+    bool LoadModel(const string& filename) {
+        try {
+            auto start = chrono::steady_clock::now();
+            trainer.network().load(filename);
+            trainer.publish();
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+            cout << "Modelo cargado desde " << filename << " en " << ms << " ms" << endl;
+            return true;
+        } catch (const exception& e) {
+            cout << "No se pudo cargar el modelo: " << e.what() << endl;
+            return false;
+        }
     }
 
     // Función para ajustar el umbral de acción
@@ -255,17 +168,27 @@ Paddle player;
 AIPaddle ai_paddle;
 
 void ResetGame() {
-    ball.Reset();
+    pong::reset_ball(ball, rng);
     player.y = screen_height/2 - player.height/2;
     ai_paddle.y = screen_height/2 - ai_paddle.height/2;
-    player_score = 0;
-    ai_score = 0;
+    score = pong::Score{};
+}
+
+// Empieza una sesión de entrenamiento reproducible: mismo estado inicial
+// que pong::Game(training_seed) en pong_train
+void StartTraining() {
+    is_training = true;
+    games_played = 0;
+    ai_paddle.StartTrainingSession();
+    rng.seed(training_seed);
+    static_cast<pong::Ball&>(ball) = pong::Ball{};
+    ResetGame();
 }
 
 void DrawUI() {
     // Dibujar scores
-    DrawText(TextFormat("%i", ai_score), screen_width/4 - 20, 20, 80, WHITE);
-    DrawText(TextFormat("%i", player_score), 3*screen_width/4 - 20, 20, 80, WHITE);
+    DrawText(TextFormat("%i", score.ai), screen_width/4 - 20, 20, 80, WHITE);
+    DrawText(TextFormat("%i", score.player), 3*screen_width/4 - 20, 20, 80, WHITE);
 
     // Dibujar información de entrenamiento
     if (is_training) {
@@ -278,13 +201,70 @@ void DrawUI() {
         DrawText("Presiona '+/-' para ajustar sensibilidad", 20, screen_height - 40, 20, WHITE);
     }
 
+    // Progreso del entrenador en segundo plano
+    auto stats = ai_paddle.TrainerStats();
+    if (stats.epochs > 0) {
+        DrawText(TextFormat("Red v%llu - época %llu - loss %.4f", (unsigned long long)stats.version,
+                            (unsigned long long)stats.epochs, stats.loss),
+                 20, screen_height - 160, 20, LIGHTGRAY);
+    }
+
     // Instrucciones
     DrawText("Controles: UP/DOWN arrows", 20, 20, 20, WHITE);
     DrawText("'T' - Entrenar IA", 20, 50, 20, WHITE);
     DrawText("'ESC' - Salir", 20, 80, 20, WHITE);
 }
 
-int main() {
+// Panel de perfilado ('P'): histograma de los últimos fotogramas, p50 y
+// máximo, y el tiempo por zona en el último fotograma
+void DrawProfiler() {
+    using utec::profiling::Profiler;
+    const int x = screen_width - 420;
+    const int y = 120;
+    DrawRectangle(x - 10, y - 10, 420, 430, Color{0, 0, 0, 170});
+    if (!utec::profiling::compiled_in) {
+        DrawText("Perfilado no compilado (PONGSASOS_PROFILE=OFF)", x, y, 10, WHITE);
+        return;
+    }
+
+    const Profiler& profiler = Profiler::instance();
+    size_t frames = min(profiler.frames(), Profiler::frame_history);
+    if (frames == 0) return;
+    vector<float> times(frames);
+    for (size_t i = 0; i < frames; ++i) times[i] = profiler.frame_ms(i);
+    sort(times.begin(), times.end());
+    DrawText(TextFormat("Fotograma: p50 %.2f ms - max %.2f ms (%i)", times[frames / 2], times.back(), (int)frames),
+             x, y, 16, WHITE);
+
+    // Una barra por milisegundo; la última junta los fotogramas más lentos
+    auto bins = profiler.histogram();
+    uint32_t highest = *max_element(bins.begin(), bins.end());
+    const int bar = 11, height = 80, base = y + 30 + height;
+    for (size_t b = 0; b < bins.size(); ++b) {
+        int h = highest ? int(bins[b] * height / highest) : 0;
+        Color color = b < 17 ? GREEN : (b < 33 ? YELLOW : Color{230, 41, 55, 255});
+        DrawRectangle(x + int(b) * bar, base - h, bar - 1, h, color);
+    }
+    DrawText("0", x, base + 4, 10, WHITE);
+    DrawText("16.7", x + 16 * bar, base + 4, 10, WHITE);
+    DrawText("33+ ms", x + 31 * bar, base + 4, 10, WHITE);
+
+    int row = base + 26;
+    DrawText("zona                         ms/fotog.  llamadas", x, row, 10, LIGHTGRAY);
+    for (const auto& zone : profiler.zones()) {
+        row += 14;
+        if (row > y + 400) break;
+        DrawText(zone.name, x, row, 10, WHITE);
+        DrawText(TextFormat("%8.3f", zone.ms), x + 200, row, 10, WHITE);
+        DrawText(TextFormat("%6u", zone.calls), x + 290, row, 10, WHITE);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        training_seed = static_cast<uint32_t>(stoul(argv[1]));
+    }
+
     InitWindow(screen_width, screen_height, "PONG AI");
     SetTargetFPS(60);
 
@@ -310,19 +290,25 @@ int main() {
     ai_paddle.speed = 6;
 
     cout << "=== PONG AI CON REDES NEURONALES ===" << endl;
+    // Un modelo guardado por una sesión anterior (o por pong_train) evita re-entrenar
+    if (ifstream(MODEL_FILE).good()) {
+        ai_paddle.LoadModel(MODEL_FILE);
+    }
     cout << "Presiona 'T' para entrenar la IA" << endl;
     cout << "Usa las flechas UP/DOWN para jugar" << endl;
     cout << "Presiona '+/-' para ajustar sensibilidad del bot" << endl;
+    cout << "Presiona 'P' para ver el perfilado y 'E' para exportar la traza" << endl;
 
     bool fast_training = false;
+    if (utec::profiling::compiled_in) {
+        utec::profiling::Profiler::instance().set_thread_name("juego");
+    }
 
     while (!WindowShouldClose()) {
         // Manejar input
         if (IsKeyPressed(KEY_T)) {
-            is_training = true;
-            games_played = 0;
+            StartTraining();
             fast_training = false;
-            ResetGame();
             cout << "Iniciando entrenamiento..." << endl;
         }
 
@@ -332,16 +318,14 @@ int main() {
         }
 
         if (IsKeyPressed(KEY_R) && !is_training) {
-            is_training = true;
-            games_played = 0;
+            StartTraining();
             fast_training = false;
-            ResetGame();
             cout << "Re-entrenando IA..." << endl;
         }
 
         if (IsKeyPressed(KEY_SPACE) && is_training) {
             is_training = false;
-            ai_paddle.TrainNetwork();
+            ai_paddle.FinishTrainingSession();
             ResetGame();
         }
 
@@ -355,11 +339,25 @@ int main() {
             cout << "Sensibilidad disminuida" << endl;
         }
 
+        if (IsKeyPressed(KEY_P)) {
+            show_profiler = !show_profiler;
+        }
+        if (IsKeyPressed(KEY_E) && utec::profiling::compiled_in) {
+            try {
+                size_t events = utec::profiling::Profiler::instance().write_chrome_trace(TRACE_FILE);
+                cout << "Traza exportada a " << TRACE_FILE << " (" << events << " eventos)" << endl;
+            } catch (const exception& e) {
+                cout << "No se pudo exportar la traza: " << e.what() << endl;
+            }
+        }
+
+        ai_paddle.ReportTrainer();
+
         // Lógica del juego
+        auto ai_controller = [](pong::Paddle&, const pong::Ball& b) { ai_paddle.Update(b); };
         if (is_training) {
-            // Modo entrenamiento automático
-            ball.Update();
-            ai_paddle.Update(ball);
+            // Modo entrenamiento automático (el jugador no se mueve)
+            pong::step(ball, player, ai_paddle, score, rng, 0, ai_controller);
 
             // Entrenamiento rápido o normal
             if (fast_training) {
@@ -369,50 +367,45 @@ int main() {
             }
 
             // Verificar si el juego terminó
-            if (ai_score >= 5 || player_score >= 5) {
+            if (score.ai >= pong::points_to_win || score.player >= pong::points_to_win) {
                 games_played++;
                 if (games_played >= TRAINING_GAMES) {
                     is_training = false;
-                    ai_paddle.TrainNetwork();
-                    cout << "¡Entrenamiento completado automáticamente!" << endl;
+                    ai_paddle.FinishTrainingSession();
+                    cout << "¡Recolección completada automáticamente!" << endl;
                 }
                 ResetGame();
             }
         } else {
             // Modo juego normal
             SetTargetFPS(60);
-            ball.Update();
-            player.Update();
-            ai_paddle.Update(ball);
-        }
-
-        // Detectar colisiones
-        if (CheckCollisionCircleRec(Vector2{ball.x, ball.y}, ball.radius,
-                                   Rectangle{player.x, player.y, player.width, player.height})) {
-            ball.speed_x *= -1;
-        }
-
-        if (CheckCollisionCircleRec(Vector2{ball.x, ball.y}, ball.radius,
-                                   Rectangle{ai_paddle.x, ai_paddle.y, ai_paddle.width, ai_paddle.height})) {
-            ball.speed_x *= -1;
+            pong::step(ball, player, ai_paddle, score, rng, player.InputDirection(), ai_controller);
         }
 
         // Dibujar
         BeginDrawing();
-        ClearBackground(blue);
-
-        // Dibujar línea central
-        DrawLine(screen_width/2, 0, screen_width/2, screen_height, WHITE);
-
-        // Dibujar elementos del juego
-        ball.Draw();
-        ai_paddle.Draw();
-        player.Draw();
-
-        // Dibujar UI
-        DrawUI();
-
+        {
+            // Sin EndDrawing, que incluye la espera del fotograma
+            PROFILE_ZONE("Draw");
+            ClearBackground(blue);
+
+            // Dibujar línea central
+            DrawLine(screen_width/2, 0, screen_width/2, screen_height, WHITE);
+
+            // Dibujar elementos del juego
+            ball.Draw();
+            ai_paddle.Draw();
+            player.Draw();
+
+            // Dibujar UI
+            DrawUI();
+            if (show_profiler) DrawProfiler();
+        }
         EndDrawing();
+
+        if (utec::profiling::compiled_in) {
+            utec::profiling::Profiler::instance().frame();
+        }
     }
 
     CloseWindow();
@@ -0,0 +1,337 @@
+#ifndef NN_ACTIVATION_H
+#define NN_ACTIVATION_H
+
+// Funciones de activación como tipos de política (sin funciones virtuales).
+//
+// Cada política ofrece:
+//  - forward(x) / backward(x): versión escalar exacta sobre la entrada x
+//    (referencia y pruebas).
+//  - forward(in, out, n): kernel sobre un arreglo completo; in y out pueden
+//    ser el mismo arreglo.
+//  - backward(grad_out, out, grad_in, n): gradiente a partir de la salida
+//    ya calculada en forward, sin recalcular la función.
+//
+// Para float los kernels tienen versiones AVX2 y AVX-512 elegidas en tiempo
+// de ejecución con el mismo selector que el GEMM (gemm::active_isa). tanh y
+// sigmoid usan una aproximación racional (numerador impar de grado 13,
+// denominador par de grado 6, entrada recortada a |x| <= 7.905) con error
+// absoluto máximo medido de 4e-7 para tanh y 2.3e-7 para
+// sigmoid(x) = (1 + tanh(x/2)) / 2, del orden del redondeo de float. Para
+// otros tipos T se usa std::tanh / std::exp.
+
+#include "gemm.h"
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <algorithm>
+#include <type_traits>
+
+namespace utec {
+namespace neural_network {
+
+namespace activation_detail {
+
+// Coeficientes de tanh(x) ~ x * P(x^2) / Q(x^2), de mayor a menor grado
+constexpr float tanh_clamp = 7.90531110763549805f;
+constexpr float tanh_p[7] = {
+    -2.76076847742355e-16f, 2.00018790482477e-13f, -8.60467152213735e-11f,
+    5.12229709037114e-08f, 1.48572235717979e-05f, 6.37261928875436e-04f,
+    4.89352455891786e-03f
+};
+constexpr float tanh_q[4] = {
+    1.19825839466702e-06f, 1.18534705686654e-04f, 2.26843463243900e-03f,
+    4.89352518554385e-03f
+};
+
+inline float fast_tanh(float x) {
+    x = std::min(std::max(x, -tanh_clamp), tanh_clamp);
+    float x2 = x * x;
+    float p = tanh_p[0];
+    for (int i = 1; i < 7; ++i) p = p * x2 + tanh_p[i];
+    float q = tanh_q[0];
+    for (int i = 1; i < 4; ++i) q = q * x2 + tanh_q[i];
+    return x * p / q;
+}
+
+#ifdef UTEC_GEMM_X86
+__attribute__((target("avx2,fma")))
+inline __m256 tanh_avx2(__m256 x) {
+    const __m256 clamp = _mm256_set1_ps(tanh_clamp);
+    x = _mm256_min_ps(_mm256_max_ps(x, _mm256_sub_ps(_mm256_setzero_ps(), clamp)), clamp);
+    __m256 x2 = _mm256_mul_ps(x, x);
+    __m256 p = _mm256_set1_ps(tanh_p[0]);
+    for (int i = 1; i < 7; ++i) p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(tanh_p[i]));
+    __m256 q = _mm256_set1_ps(tanh_q[0]);
+    for (int i = 1; i < 4; ++i) q = _mm256_fmadd_ps(q, x2, _mm256_set1_ps(tanh_q[i]));
+    return _mm256_div_ps(_mm256_mul_ps(x, p), q);
+}
+
+// min/max con máscara completa: las versiones sin máscara de GCC 12 parten
+// de _mm512_undefined_ps y disparan -Wmaybe-uninitialized
+__attribute__((target("avx512f")))
+inline __m512 max_avx512(__m512 a, __m512 b) { return _mm512_maskz_max_ps(0xFFFF, a, b); }
+
+__attribute__((target("avx512f")))
+inline __m512 min_avx512(__m512 a, __m512 b) { return _mm512_maskz_min_ps(0xFFFF, a, b); }
+
+__attribute__((target("avx512f")))
+inline __m512 tanh_avx512(__m512 x) {
+    const __m512 clamp = _mm512_set1_ps(tanh_clamp);
+    x = min_avx512(max_avx512(x, _mm512_sub_ps(_mm512_setzero_ps(), clamp)), clamp);
+    __m512 x2 = _mm512_mul_ps(x, x);
+    __m512 p = _mm512_set1_ps(tanh_p[0]);
+    for (int i = 1; i < 7; ++i) p = _mm512_fmadd_ps(p, x2, _mm512_set1_ps(tanh_p[i]));
+    __m512 q = _mm512_set1_ps(tanh_q[0]);
+    for (int i = 1; i < 4; ++i) q = _mm512_fmadd_ps(q, x2, _mm512_set1_ps(tanh_q[i]));
+    return _mm512_div_ps(_mm512_mul_ps(x, p), q);
+}
+#endif
+
+// Operaciones elemento a elemento en sus tres variantes. Las unarias
+// calculan la activación; las binarias reciben (grad_out, salida).
+struct ReluForward {
+    static float scalar(float x) { return x > 0.0f ? x : 0.0f; }
+#ifdef UTEC_GEMM_X86
+    __attribute__((target("avx2,fma"))) static __m256 avx2(__m256 x) {
+        return _mm256_max_ps(x, _mm256_setzero_ps());
+    }
+    __attribute__((target("avx512f"))) static __m512 avx512(__m512 x) {
+        return max_avx512(x, _mm512_setzero_ps());
+    }
+#endif
+};
+
+struct ReluBackward {
+    static float scalar(float g, float y) { return y > 0.0f ? g : 0.0f; }
+#ifdef UTEC_GEMM_X86
+    __attribute__((target("avx2,fma"))) static __m256 avx2(__m256 g, __m256 y) {
+        return _mm256_and_ps(g, _mm256_cmp_ps(y, _mm256_setzero_ps(), _CMP_GT_OQ));
+    }
+    __attribute__((target("avx512f"))) static __m512 avx512(__m512 g, __m512 y) {
+        return _mm512_maskz_mov_ps(_mm512_cmp_ps_mask(y, _mm512_setzero_ps(), _CMP_GT_OQ), g);
+    }
+#endif
+};
+
+struct TanhForward {
+    static float scalar(float x) { return fast_tanh(x); }
+#ifdef UTEC_GEMM_X86
+    __attribute__((target("avx2,fma"))) static __m256 avx2(__m256 x) { return tanh_avx2(x); }
+    __attribute__((target("avx512f"))) static __m512 avx512(__m512 x) { return tanh_avx512(x); }
+#endif
+};
+
+// g * (1 - y^2)
+struct TanhBackward {
+    static float scalar(float g, float y) { return g * (1.0f - y * y); }
+#ifdef UTEC_GEMM_X86
+    __attribute__((target("avx2,fma"))) static __m256 avx2(__m256 g, __m256 y) {
+        return _mm256_mul_ps(g, _mm256_fnmadd_ps(y, y, _mm256_set1_ps(1.0f)));
+    }
+    __attribute__((target("avx512f"))) static __m512 avx512(__m512 g, __m512 y) {
+        return _mm512_mul_ps(g, _mm512_fnmadd_ps(y, y, _mm512_set1_ps(1.0f)));
+    }
+#endif
+};
+
+// (1 + tanh(x / 2)) / 2
+struct SigmoidForward {
+    static float scalar(float x) { return 0.5f + 0.5f * fast_tanh(0.5f * x); }
+#ifdef UTEC_GEMM_X86
+    __attribute__((target("avx2,fma"))) static __m256 avx2(__m256 x) {
+        const __m256 half = _mm256_set1_ps(0.5f);
+        return _mm256_fmadd_ps(half, tanh_avx2(_mm256_mul_ps(half, x)), half);
+    }
+    __attribute__((target("avx512f"))) static __m512 avx512(__m512 x) {
+        const __m512 half = _mm512_set1_ps(0.5f);
+        return _mm512_fmadd_ps(half, tanh_avx512(_mm512_mul_ps(half, x)), half);
+    }
+#endif
+};
+
+// g * y * (1 - y)
+struct SigmoidBackward {
+    static float scalar(float g, float y) { return g * y * (1.0f - y); }
+#ifdef UTEC_GEMM_X86
+    __attribute__((target("avx2,fma"))) static __m256 avx2(__m256 g, __m256 y) {
+        return _mm256_mul_ps(_mm256_mul_ps(g, y), _mm256_sub_ps(_mm256_set1_ps(1.0f), y));
+    }
+    __attribute__((target("avx512f"))) static __m512 avx512(__m512 g, __m512 y) {
+        return _mm512_mul_ps(_mm512_mul_ps(g, y), _mm512_sub_ps(_mm512_set1_ps(1.0f), y));
+    }
+#endif
+};
+
+// Recorridos de arreglos completos. El resto (n no múltiplo del ancho) se
+// procesa con cargas/escrituras enmascaradas, así todos los elementos usan
+// exactamente la misma fórmula.
+#ifdef UTEC_GEMM_X86
+__attribute__((target("avx2,fma")))
+inline __m256i tail_mask_avx2(size_t remaining) {
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(remaining)), lanes);
+}
+
+template<typename Op>
+__attribute__((target("avx2,fma")))
+void map_avx2(const float* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, Op::avx2(_mm256_loadu_ps(in + i)));
+    }
+    if (i < n) {
+        __m256i mask = tail_mask_avx2(n - i);
+        _mm256_maskstore_ps(out + i, mask, Op::avx2(_mm256_maskload_ps(in + i, mask)));
+    }
+}
+
+template<typename Op>
+__attribute__((target("avx2,fma")))
+void map_avx2(const float* a, const float* b, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, Op::avx2(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    }
+    if (i < n) {
+        __m256i mask = tail_mask_avx2(n - i);
+        _mm256_maskstore_ps(out + i, mask,
+                            Op::avx2(_mm256_maskload_ps(a + i, mask), _mm256_maskload_ps(b + i, mask)));
+    }
+}
+
+template<typename Op>
+__attribute__((target("avx512f")))
+void map_avx512(const float* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(out + i, Op::avx512(_mm512_loadu_ps(in + i)));
+    }
+    if (i < n) {
+        __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+        _mm512_mask_storeu_ps(out + i, mask, Op::avx512(_mm512_maskz_loadu_ps(mask, in + i)));
+    }
+}
+
+template<typename Op>
+__attribute__((target("avx512f")))
+void map_avx512(const float* a, const float* b, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(out + i, Op::avx512(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+    }
+    if (i < n) {
+        __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+        _mm512_mask_storeu_ps(out + i, mask,
+                              Op::avx512(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i)));
+    }
+}
+#endif
+
+template<typename Op>
+void map(const float* in, float* out, size_t n) {
+#ifdef UTEC_GEMM_X86
+    switch (utec::algebra::gemm::active_isa()) {
+        case utec::algebra::gemm::Isa::avx512: map_avx512<Op>(in, out, n); return;
+        case utec::algebra::gemm::Isa::avx2:   map_avx2<Op>(in, out, n); return;
+        default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) out[i] = Op::scalar(in[i]);
+}
+
+template<typename Op>
+void map(const float* a, const float* b, float* out, size_t n) {
+#ifdef UTEC_GEMM_X86
+    switch (utec::algebra::gemm::active_isa()) {
+        case utec::algebra::gemm::Isa::avx512: map_avx512<Op>(a, b, out, n); return;
+        case utec::algebra::gemm::Isa::avx2:   map_avx2<Op>(a, b, out, n); return;
+        default: break;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) out[i] = Op::scalar(a[i], b[i]);
+}
+
+} // namespace activation_detail
+
+template<typename T>
+struct ReLU {
+    static T forward(T x) { return std::max(T{0}, x); }
+    static T backward(T x) { return x > T{0} ? T{1} : T{0}; }
+    static std::string name() { return "relu"; }
+
+    static void forward(const T* in, T* out, size_t n) {
+        if constexpr (std::is_same_v<T, float>) {
+            activation_detail::map<activation_detail::ReluForward>(in, out, n);
+        } else {
+            for (size_t i = 0; i < n; ++i) out[i] = forward(in[i]);
+        }
+    }
+
+    // relu'(x) = 1 si la salida es positiva
+    static void backward(const T* grad_out, const T* out, T* grad_in, size_t n) {
+        if constexpr (std::is_same_v<T, float>) {
+            activation_detail::map<activation_detail::ReluBackward>(grad_out, out, grad_in, n);
+        } else {
+            for (size_t i = 0; i < n; ++i) grad_in[i] = out[i] > T{0} ? grad_out[i] : T{0};
+        }
+    }
+};
+
+template<typename T>
+struct Tanh {
+    static T forward(T x) { return std::tanh(x); }
+    static T backward(T x) {
+        T tanh_x = std::tanh(x);
+        return T{1} - tanh_x * tanh_x;
+    }
+    static std::string name() { return "tanh"; }
+
+    static void forward(const T* in, T* out, size_t n) {
+        if constexpr (std::is_same_v<T, float>) {
+            activation_detail::map<activation_detail::TanhForward>(in, out, n);
+        } else {
+            for (size_t i = 0; i < n; ++i) out[i] = std::tanh(in[i]);
+        }
+    }
+
+    // tanh'(x) = 1 - y^2 con y = tanh(x) guardado del forward
+    static void backward(const T* grad_out, const T* out, T* grad_in, size_t n) {
+        if constexpr (std::is_same_v<T, float>) {
+            activation_detail::map<activation_detail::TanhBackward>(grad_out, out, grad_in, n);
+        } else {
+            for (size_t i = 0; i < n; ++i) grad_in[i] = grad_out[i] * (T{1} - out[i] * out[i]);
+        }
+    }
+};
+
+template<typename T>
+struct Sigmoid {
+    static T forward(T x) { return T{1} / (T{1} + std::exp(-x)); }
+    static T backward(T x) {
+        T sig_x = forward(x);
+        return sig_x * (T{1} - sig_x);
+    }
+    static std::string name() { return "sigmoid"; }
+
+    static void forward(const T* in, T* out, size_t n) {
+        if constexpr (std::is_same_v<T, float>) {
+            activation_detail::map<activation_detail::SigmoidForward>(in, out, n);
+        } else {
+            for (size_t i = 0; i < n; ++i) out[i] = forward(in[i]);
+        }
+    }
+
+    // sigmoid'(x) = y * (1 - y) con y = sigmoid(x) guardado del forward
+    static void backward(const T* grad_out, const T* out, T* grad_in, size_t n) {
+        if constexpr (std::is_same_v<T, float>) {
+            activation_detail::map<activation_detail::SigmoidBackward>(grad_out, out, grad_in, n);
+        } else {
+            for (size_t i = 0; i < n; ++i) grad_in[i] = grad_out[i] * out[i] * (T{1} - out[i]);
+        }
+    }
+};
+
+} // namespace neural_network
+} // namespace utec
+
+#endif // NN_ACTIVATION_H
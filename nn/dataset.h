@@ -0,0 +1,312 @@
+#ifndef NN_DATASET_H
+#define NN_DATASET_H
+
+// Dataset de entrenamiento por trozos (chunks) de tamaño fijo.
+//
+// Cada trozo guarda chunk_rows filas en dos bloques columnares: primero las
+// entradas (chunk_rows x input_cols) y después los objetivos
+// (chunk_rows x target_cols), ambos en row-major. Agregar una fila nunca
+// mueve las anteriores ni asigna memoria salvo al abrir un trozo nuevo, y
+// NeuralNetwork::train lee los mini-batches directamente de los trozos.
+//
+// Con spill_to(path) los trozos llenos se escriben a un archivo y se leen
+// desde un mapeo en memoria: en RAM sólo queda el trozo que se está
+// llenando, así que se pueden acumular millones de filas (y varias
+// sesiones, porque el archivo se puede volver a abrir) con memoria acotada.
+//
+// Archivo: [DatasetHeader, 64 bytes][trozo 0][trozo 1]... con el último
+// trozo posiblemente incompleto (header.rows indica cuántas filas valen).
+
+#include "serialization.h"
+#include "tensor.h"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <filesystem>
+#include <stdexcept>
+
+namespace utec {
+namespace neural_network {
+
+namespace dataset_detail {
+
+constexpr char magic[8] = {'P', 'S', 'N', 'N', 'D', 'S', 'E', 'T'};
+constexpr uint32_t format_version = 1;
+
+struct alignas(64) DatasetHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t scalar_size;
+    uint32_t byte_order;
+    uint32_t reserved;
+    uint64_t input_cols;
+    uint64_t target_cols;
+    uint64_t chunk_rows;
+    uint64_t rows;
+};
+
+static_assert(sizeof(DatasetHeader) == 64, "DatasetHeader must be 64 bytes");
+
+} // namespace dataset_detail
+
+template<typename T>
+class ChunkedDataset {
+public:
+    using ConstView = utec::algebra::MatrixView<const T>;
+
+    static constexpr size_t default_chunk_rows = 4096;
+
+private:
+    size_t input_cols_;
+    size_t target_cols_;
+    size_t chunk_rows_;
+    size_t chunk_shift_;          // chunk_rows_ = 1 << chunk_shift_
+    size_t rows_ = 0;
+
+    // Trozos en memoria, después de los spilled_ trozos del archivo
+    std::vector<std::vector<T>> chunks_;
+
+    // Trozos en el archivo de spill, leídos a través de mapped_
+    std::string path_;
+    std::fstream file_;
+    std::unique_ptr<serialization::MappedFile> mapped_;
+    size_t spilled_ = 0;
+
+    size_t chunk_elements() const { return chunk_rows_ * (input_cols_ + target_cols_); }
+    size_t chunk_bytes() const { return chunk_elements() * sizeof(T); }
+
+    const T* chunk_data(size_t c) const {
+        if (c < spilled_) {
+            return reinterpret_cast<const T*>(mapped_->data() + sizeof(dataset_detail::DatasetHeader)) +
+                   c * chunk_elements();
+        }
+        return chunks_[c - spilled_].data();
+    }
+
+    dataset_detail::DatasetHeader header() const {
+        dataset_detail::DatasetHeader header{};
+        std::copy(std::begin(dataset_detail::magic), std::end(dataset_detail::magic), header.magic);
+        header.version = dataset_detail::format_version;
+        header.scalar_size = sizeof(T);
+        header.byte_order = serialization::byte_order_mark;
+        header.input_cols = input_cols_;
+        header.target_cols = target_cols_;
+        header.chunk_rows = chunk_rows_;
+        header.rows = rows_;
+        return header;
+    }
+
+    void write_at(size_t offset, const void* bytes, size_t count) {
+        file_.seekp(static_cast<std::streamoff>(offset));
+        file_.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(count));
+        if (!file_) {
+            throw std::runtime_error("Cannot write dataset file: " + path_);
+        }
+    }
+
+    void write_header() {
+        auto h = header();
+        write_at(0, &h, sizeof(h));
+    }
+
+    // Escribe el trozo en memoria más antiguo (lleno) al archivo
+    void spill_front() {
+        write_at(sizeof(dataset_detail::DatasetHeader) + spilled_ * chunk_bytes(),
+                 chunks_.front().data(), chunk_bytes());
+        ++spilled_;
+        write_header();
+        file_.flush();
+        mapped_ = std::make_unique<serialization::MappedFile>(path_);
+
+        // El buffer se reutiliza para el trozo siguiente
+        std::vector<T> buffer = std::move(chunks_.front());
+        chunks_.erase(chunks_.begin());
+        chunks_.push_back(std::move(buffer));
+    }
+
+public:
+    // chunk_rows debe ser potencia de dos (la fila r está en el trozo
+    // r >> shift)
+    ChunkedDataset(size_t input_cols, size_t target_cols, size_t chunk_rows = default_chunk_rows)
+        : input_cols_(input_cols), target_cols_(target_cols), chunk_rows_(chunk_rows), chunk_shift_(0) {
+        if (chunk_rows == 0 || (chunk_rows & (chunk_rows - 1)) != 0) {
+            throw std::invalid_argument("Dataset chunk_rows must be a power of two");
+        }
+        while ((size_t{1} << chunk_shift_) < chunk_rows) ++chunk_shift_;
+    }
+
+    ChunkedDataset(ChunkedDataset&&) noexcept = default;
+    ChunkedDataset& operator=(ChunkedDataset&&) noexcept = default;
+    ChunkedDataset(const ChunkedDataset&) = delete;
+    ChunkedDataset& operator=(const ChunkedDataset&) = delete;
+
+    ~ChunkedDataset() {
+        try {
+            flush();
+        } catch (...) {
+            // Sin excepciones en el destructor: flush() explícito para enterarse
+        }
+    }
+
+    // Agrega una fila (input_cols entradas y target_cols objetivos)
+    void append(const T* input, const T* target) {
+        size_t row = rows_ & (chunk_rows_ - 1);
+        if (row == 0) {
+            if (!path_.empty() && !chunks_.empty()) {
+                spill_front();
+            } else {
+                chunks_.emplace_back(chunk_elements());
+            }
+        }
+        T* chunk = chunks_.back().data();
+        std::copy_n(input, input_cols_, chunk + row * input_cols_);
+        std::copy_n(target, target_cols_, chunk + chunk_rows_ * input_cols_ + row * target_cols_);
+        ++rows_;
+    }
+
+    // Agrega todas las filas de other (mismas columnas)
+    void append(const ChunkedDataset& other) {
+        if (other.input_cols_ != input_cols_ || other.target_cols_ != target_cols_) {
+            throw std::invalid_argument("Dataset columns do not match");
+        }
+        for (size_t r = 0; r < other.rows_; ++r) {
+            append(other.input(r), other.target(r));
+        }
+    }
+
+    // Olvida todas las filas (y las del archivo de spill, si lo hay)
+    void clear() {
+        rows_ = 0;
+        chunks_.clear();
+        if (!path_.empty()) {
+            spilled_ = 0;
+            mapped_.reset();
+            write_header();
+            file_.flush();
+            std::filesystem::resize_file(path_, sizeof(dataset_detail::DatasetHeader));
+        }
+    }
+
+    // Guarda las filas nuevas en path y, desde ahora, manda ahí cada trozo
+    // lleno. Si path ya es un dataset con las mismas columnas sus filas se
+    // recuperan primero (la recolección continúa donde quedó). Sólo se
+    // puede llamar con el dataset vacío.
+    void spill_to(const std::string& path) {
+        namespace fs = std::filesystem;
+        if (rows_ != 0 || !path_.empty()) {
+            throw std::logic_error("spill_to must be called on an empty dataset");
+        }
+
+        size_t rows = 0;
+        if (fs::exists(path) && fs::file_size(path) > 0) {
+            serialization::MappedFile existing(path);
+            dataset_detail::DatasetHeader h{};
+            if (existing.size() < sizeof(h)) {
+                throw std::runtime_error("Dataset file too small: " + path);
+            }
+            std::memcpy(&h, existing.data(), sizeof(h));
+            if (std::memcmp(h.magic, dataset_detail::magic, sizeof(h.magic)) != 0 ||
+                h.version != dataset_detail::format_version || h.scalar_size != sizeof(T) ||
+                h.byte_order != serialization::byte_order_mark) {
+                throw std::runtime_error("Not a compatible dataset file: " + path);
+            }
+            if (h.input_cols != input_cols_ || h.target_cols != target_cols_ || h.chunk_rows != chunk_rows_) {
+                throw std::runtime_error("Dataset file has a different layout: " + path);
+            }
+            size_t chunks = (h.rows + chunk_rows_ - 1) / chunk_rows_;
+            if (existing.size() < sizeof(h) + chunks * chunk_bytes()) {
+                throw std::runtime_error("Dataset file is truncated: " + path);
+            }
+            rows = h.rows;
+        } else {
+            std::ofstream(path, std::ios::binary | std::ios::trunc);
+        }
+
+        file_.open(path, std::ios::binary | std::ios::in | std::ios::out);
+        if (!file_) {
+            throw std::runtime_error("Cannot open dataset file: " + path);
+        }
+        path_ = path;
+        spilled_ = rows >> chunk_shift_;
+        rows_ = spilled_ << chunk_shift_;
+        chunks_.clear();
+        write_header();
+        file_.flush();
+        if (rows == 0) return;
+
+        // Un último trozo incompleto vuelve a memoria para seguir llenándolo
+        mapped_ = std::make_unique<serialization::MappedFile>(path_);
+        if (rows > rows_) {
+            const T* tail = reinterpret_cast<const T*>(mapped_->data() + sizeof(dataset_detail::DatasetHeader)) +
+                            spilled_ * chunk_elements();
+            chunks_.emplace_back(tail, tail + chunk_elements());
+            rows_ = rows;
+        }
+    }
+
+    // Escribe en el archivo el trozo que se está llenando y el número de
+    // filas (también lo hace el destructor); sin spill no hace nada
+    void flush() {
+        if (path_.empty()) return;
+        if (rows_ > (spilled_ << chunk_shift_)) {
+            write_at(sizeof(dataset_detail::DatasetHeader) + spilled_ * chunk_bytes(),
+                     chunks_.back().data(), chunk_bytes());
+        }
+        write_header();
+        file_.flush();
+    }
+
+    size_t size() const { return rows_; }
+    size_t rows() const { return rows_; }
+    bool empty() const { return rows_ == 0; }
+    size_t input_cols() const { return input_cols_; }
+    size_t target_cols() const { return target_cols_; }
+    size_t chunk_rows() const { return chunk_rows_; }
+    size_t chunk_count() const { return spilled_ + chunks_.size(); }
+    size_t spilled_chunks() const { return spilled_; }
+
+    // Memoria de los trozos que viven en RAM (no cuenta el mapeo)
+    size_t resident_bytes() const { return chunks_.size() * chunk_bytes(); }
+
+    // Entradas y objetivos de la fila r
+    const T* input(size_t r) const {
+        return chunk_data(r >> chunk_shift_) + (r & (chunk_rows_ - 1)) * input_cols_;
+    }
+
+    const T* target(size_t r) const {
+        return chunk_data(r >> chunk_shift_) + chunk_rows_ * input_cols_ + (r & (chunk_rows_ - 1)) * target_cols_;
+    }
+
+    // Todas las filas como dos matrices, si caben en un solo trozo
+    bool contiguous(ConstView& inputs, ConstView& targets) const {
+        if (chunk_count() != 1) return false;
+        const T* chunk = chunk_data(0);
+        inputs = {chunk, rows_, input_cols_};
+        targets = {chunk + chunk_rows_ * input_cols_, rows_, target_cols_};
+        return true;
+    }
+
+    // Huella FNV-1a de todas las entradas seguidas de todos los objetivos,
+    // para comparar datasets entre ejecuciones
+    uint64_t checksum() const {
+        uint64_t hash = 1469598103934665603ull;
+        for (size_t block = 0; block < 2; ++block) {
+            for (size_t c = 0; c < chunk_count(); ++c) {
+                size_t rows = std::min(chunk_rows_, rows_ - (c << chunk_shift_));
+                size_t cols = block == 0 ? input_cols_ : target_cols_;
+                const T* data = chunk_data(c) + (block == 0 ? 0 : chunk_rows_ * input_cols_);
+                hash = serialization::fnv1a(reinterpret_cast<const unsigned char*>(data), rows * cols * sizeof(T), hash);
+            }
+        }
+        return hash;
+    }
+};
+
+} // namespace neural_network
+} // namespace utec
+
+#endif // NN_DATASET_H
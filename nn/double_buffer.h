@@ -0,0 +1,75 @@
+#ifndef NN_DOUBLE_BUFFER_H
+#define NN_DOUBLE_BUFFER_H
+
+// Publicación de un objeto entre dos hilos al estilo RCU, con doble buffer.
+// El escritor prepara la copia que no está publicada y la publica con un
+// store atómico; el lector (uno solo) siempre ve una copia completa y nunca
+// espera. Antes de reutilizar la copia vieja el escritor espera a que el
+// lector termine con ella (el "grace period" de RCU), lo que dura a lo más
+// una llamada a read().
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace utec {
+namespace parallel {
+
+template<typename T>
+class DoubleBuffer {
+private:
+    T buffers_[2]{};
+    std::atomic<unsigned> published_{0};
+    std::atomic<int> reading_{-1};       // copia que usa el lector, -1 ninguna
+    std::atomic<uint64_t> version_{0};
+
+    struct ReadGuard {
+        std::atomic<int>& reading;
+        ~ReadGuard() { reading.store(-1, std::memory_order_release); }
+    };
+
+public:
+    DoubleBuffer() = default;
+    explicit DoubleBuffer(const T& initial) : buffers_{initial, initial} {}
+
+    DoubleBuffer(const DoubleBuffer&) = delete;
+    DoubleBuffer& operator=(const DoubleBuffer&) = delete;
+
+    // Sólo el lector: llama a f con la copia publicada, que no cambia
+    // mientras f corre. f debe ser corta (el escritor puede estar esperando)
+    template<typename F>
+    decltype(auto) read(F&& f) {
+        // Se anuncia la copia y se verifica que siga publicada: si el
+        // escritor publicó entre medio, se reintenta con la nueva
+        unsigned index = published_.load();
+        while (true) {
+            reading_.store(int(index));
+            unsigned now = published_.load();
+            if (now == index) break;
+            index = now;
+        }
+        ReadGuard guard{reading_};
+        return f(static_cast<const T&>(buffers_[index]));
+    }
+
+    // Sólo el escritor: update(copia) deja lista la copia no publicada (que
+    // tiene el contenido de dos publicaciones atrás) y luego se publica
+    template<typename F>
+    void write(F&& update) {
+        unsigned next = 1 - published_.load(std::memory_order_relaxed);
+        while (reading_.load() == int(next)) {
+            std::this_thread::yield();
+        }
+        update(buffers_[next]);
+        published_.store(next);
+        version_.fetch_add(1, std::memory_order_release);
+    }
+
+    // Número de publicaciones hechas
+    uint64_t version() const { return version_.load(std::memory_order_acquire); }
+};
+
+} // namespace parallel
+} // namespace utec
+
+#endif // NN_DOUBLE_BUFFER_H
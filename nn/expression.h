@@ -0,0 +1,224 @@
+#ifndef NN_EXPRESSION_H
+#define NN_EXPRESSION_H
+
+// Expresiones perezosas para la aritmética de Tensor: a + b * s - c no
+// calcula nada por sí sola, arma un árbol de nodos pequeños que se evalúa
+// elemento a elemento en un único recorrido al asignarlo a un Tensor (o con
+// eval()), sin temporales intermedios.
+//
+// Los nodos guardan por referencia los operandos que son lvalues y por
+// valor los temporales (que se mueven dentro del nodo), así que
+//     auto e = a + b;        // referencia a a y b: deben seguir vivos
+//     auto f = (a + b) * 2;  // el nodo (a + b) se copia dentro de f
+// Una expresión se puede indexar con operator() como un Tensor, pero
+// cada acceso recalcula el elemento: para leerla muchas veces conviene
+// evaluarla primero.
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace utec {
+namespace algebra {
+
+template<typename T, size_t N>
+class Tensor;
+
+// Base de todas las expresiones (incluido Tensor). Derived define shape(),
+// size() y operator[](i), el elemento i en orden row-major.
+template<typename Derived, typename T, size_t N>
+struct Expression {
+    using value_type = T;
+    using expression_tag = void;
+    static constexpr size_t rank = N;
+
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+
+    // Elemento por índices, como Tensor::operator() (sin comprobar rangos)
+    template<typename... Idx>
+    T operator()(Idx... indices) const {
+        static_assert(sizeof...(Idx) == N, "Number of indices must match tensor rank");
+        const auto& shape = derived().shape();
+        const size_t idx[] = {static_cast<size_t>(indices)...};
+        size_t off = 0;
+        for (size_t i = 0; i < N; ++i) {
+            off = off * shape[i] + idx[i];
+        }
+        return derived()[off];
+    }
+
+    Tensor<T, N> eval() const { return Tensor<T, N>(derived()); }
+
+    // Aplica func a cada elemento (también perezoso)
+    template<typename Func>
+    auto apply(Func func) const&;
+    template<typename Func>
+    auto apply(Func func) &&;
+};
+
+template<typename E>
+concept TensorExpression = requires { typename std::remove_cvref_t<E>::expression_tag; };
+
+template<typename L, typename R>
+concept CompatibleExpressions =
+    TensorExpression<L> && TensorExpression<R> &&
+    std::is_same_v<typename std::remove_cvref_t<L>::value_type, typename std::remove_cvref_t<R>::value_type> &&
+    std::remove_cvref_t<L>::rank == std::remove_cvref_t<R>::rank;
+
+namespace expression_detail {
+
+// Cómo guarda un nodo a su operando: referencia si es lvalue, copia si no
+template<typename E>
+using Operand = std::conditional_t<std::is_lvalue_reference_v<E>,
+                                   const std::remove_reference_t<E>&,
+                                   std::remove_cvref_t<E>>;
+
+template<typename E>
+using Value = typename std::remove_cvref_t<E>::value_type;
+
+struct Add {
+    static constexpr const char* mismatch = "Tensor shapes must match for addition";
+    template<typename T>
+    T operator()(T a, T b) const { return a + b; }
+};
+
+struct Subtract {
+    static constexpr const char* mismatch = "Tensor shapes must match for subtraction";
+    template<typename T>
+    T operator()(T a, T b) const { return a - b; }
+};
+
+struct Multiply {
+    template<typename T>
+    T operator()(T a, T b) const { return a * b; }
+};
+
+// Elemento a elemento entre dos expresiones de la misma forma
+template<typename Op, typename L, typename R>
+class Binary : public Expression<Binary<Op, L, R>, Value<L>, std::remove_cvref_t<L>::rank> {
+private:
+    L left_;
+    R right_;
+
+public:
+    template<typename A, typename B>
+    Binary(A&& left, B&& right) : left_(std::forward<A>(left)), right_(std::forward<B>(right)) {
+        if (left_.shape() != right_.shape()) {
+            throw std::invalid_argument(Op::mismatch);
+        }
+    }
+
+    const auto& shape() const { return left_.shape(); }
+    size_t size() const { return left_.size(); }
+    Value<L> operator[](size_t i) const { return Op{}(left_[i], right_[i]); }
+};
+
+// Expresión con un escalar
+template<typename Op, typename E>
+class Scalar : public Expression<Scalar<Op, E>, Value<E>, std::remove_cvref_t<E>::rank> {
+private:
+    E expression_;
+    Value<E> scalar_;
+
+public:
+    template<typename A>
+    Scalar(A&& expression, Value<E> scalar) : expression_(std::forward<A>(expression)), scalar_(scalar) {}
+
+    const auto& shape() const { return expression_.shape(); }
+    size_t size() const { return expression_.size(); }
+    Value<E> operator[](size_t i) const { return Op{}(expression_[i], scalar_); }
+};
+
+// func(x) para cada elemento
+template<typename Func, typename E>
+class Map : public Expression<Map<Func, E>, Value<E>, std::remove_cvref_t<E>::rank> {
+private:
+    E expression_;
+    Func func_;
+
+public:
+    template<typename A>
+    Map(A&& expression, Func func) : expression_(std::forward<A>(expression)), func_(std::move(func)) {}
+
+    const auto& shape() const { return expression_.shape(); }
+    size_t size() const { return expression_.size(); }
+    Value<E> operator[](size_t i) const { return func_(expression_[i]); }
+};
+
+// Elementos por bloque del recorrido: con un bloque de longitud fija el
+// compilador vectoriza el cuerpo también en -O2, y el resto (< block)
+// se hace elemento a elemento
+constexpr size_t block = 16;
+
+// out[i] = op(out[i], expression[i]) en un solo recorrido (Assign ignora
+// out[i]). Cada elemento depende sólo de los elementos i de los operandos,
+// así que out puede ser uno de ellos (a = a + b) y el bucle no tiene
+// dependencias entre iteraciones.
+struct Assign {
+    template<typename T>
+    T operator()(T, T b) const { return b; }
+};
+
+template<typename Op, typename T, typename E>
+void evaluate(T* out, const E& expression, size_t n) {
+    size_t i = 0;
+    for (; i + block <= n; i += block) {
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC ivdep
+#endif
+        for (size_t j = i; j < i + block; ++j) {
+            out[j] = Op{}(out[j], expression[j]);
+        }
+    }
+    for (; i < n; ++i) {
+        out[i] = Op{}(out[i], expression[i]);
+    }
+}
+
+} // namespace expression_detail
+
+template<typename Derived, typename T, size_t N>
+template<typename Func>
+auto Expression<Derived, T, N>::apply(Func func) const& {
+    return expression_detail::Map<Func, const Derived&>(derived(), std::move(func));
+}
+
+template<typename Derived, typename T, size_t N>
+template<typename Func>
+auto Expression<Derived, T, N>::apply(Func func) && {
+    return expression_detail::Map<Func, Derived>(static_cast<Derived&&>(*this), std::move(func));
+}
+
+template<typename L, typename R>
+    requires CompatibleExpressions<L, R>
+auto operator+(L&& left, R&& right) {
+    using namespace expression_detail;
+    return Binary<Add, Operand<L>, Operand<R>>(std::forward<L>(left), std::forward<R>(right));
+}
+
+template<typename L, typename R>
+    requires CompatibleExpressions<L, R>
+auto operator-(L&& left, R&& right) {
+    using namespace expression_detail;
+    return Binary<Subtract, Operand<L>, Operand<R>>(std::forward<L>(left), std::forward<R>(right));
+}
+
+template<typename E>
+    requires TensorExpression<E>
+auto operator*(E&& expression, expression_detail::Value<E> scalar) {
+    using namespace expression_detail;
+    return Scalar<Multiply, Operand<E>>(std::forward<E>(expression), scalar);
+}
+
+template<typename E>
+    requires TensorExpression<E>
+auto operator*(expression_detail::Value<E> scalar, E&& expression) {
+    return std::forward<E>(expression) * scalar;
+}
+
+} // namespace algebra
+} // namespace utec
+
+#endif // NN_EXPRESSION_H
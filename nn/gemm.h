@@ -0,0 +1,447 @@
+#ifndef NN_GEMM_H
+#define NN_GEMM_H
+
+// Kernel GEMM (C = A * B, row-major) usado por Tensor::matmul.
+//
+// Estructura clásica de tres niveles de bloqueo (estilo GotoBLAS/BLIS):
+//  - B se empaqueta en paneles de KC x NR y A en paneles de MC x KC (MR filas
+//    intercaladas), de modo que el micro-kernel lee memoria contigua.
+//  - El micro-kernel mantiene un bloque MR x NR de C en registros y hace
+//    una FMA por elemento de A difundido (broadcast) contra una fila de B.
+//  - Para float hay micro-kernels AVX2/FMA (6x16) y AVX-512 (12x16),
+//    elegidos en tiempo de ejecución; para cualquier otro caso se usa un
+//    micro-kernel escalar genérico con la misma estructura de paneles.
+//  - Opcionalmente un epílogo (bias + activación) se aplica a cada bloque
+//    de C en cuanto queda terminado, mientras sigue en caché, en lugar de
+//    recorrer la matriz de salida otra vez.
+
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define UTEC_GEMM_X86 1
+#include <immintrin.h>
+#endif
+
+namespace utec {
+namespace algebra {
+namespace gemm {
+
+enum class Isa { scalar, avx2, avx512 };
+
+inline const char* isa_name(Isa isa) {
+    switch (isa) {
+        case Isa::avx512: return "avx512";
+        case Isa::avx2:   return "avx2";
+        default:          return "scalar";
+    }
+}
+
+// Mejor conjunto de instrucciones disponible en la CPU actual
+inline Isa detected_isa() {
+#ifdef UTEC_GEMM_X86
+    static const Isa isa = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return Isa::avx512;
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return Isa::avx2;
+        return Isa::scalar;
+    }();
+    return isa;
+#else
+    return Isa::scalar;
+#endif
+}
+
+// Trabajo extra sobre C = A * B: C[i][j] += bias[j] y luego
+// C = activation(C). Cualquiera de los dos puede ser nulo.
+template<typename T>
+struct Epilogue {
+    using Activation = void (*)(const T* in, T* out, size_t n);
+
+    const T* bias = nullptr;
+    Activation activation = nullptr;
+
+    bool empty() const { return bias == nullptr && activation == nullptr; }
+};
+
+namespace detail {
+
+// Tamaños de bloque: KC x NR de B cabe en L1, MC x KC de A en L2
+constexpr size_t KC = 256;
+constexpr size_t MC = 96;
+constexpr size_t NC = 4096;
+
+inline Isa& forced_isa() {
+    static Isa isa = detected_isa();
+    return isa;
+}
+
+// Firma común de los micro-kernels: calcula un bloque mr x nr de C a partir
+// de un panel de A (kc x MR) y uno de B (kc x NR). Si accumulate es falso, C
+// se sobrescribe.
+template<typename T>
+using MicroKernel = void (*)(size_t kc, const T* a, const T* b, T* c, size_t ldc,
+                             size_t mr, size_t nr, bool accumulate);
+
+template<typename T, size_t MR, size_t NR>
+void micro_kernel_scalar(size_t kc, const T* a, const T* b, T* c, size_t ldc,
+                         size_t mr, size_t nr, bool accumulate) {
+    T acc[MR][NR] = {};
+    for (size_t p = 0; p < kc; ++p) {
+        const T* bp = b + p * NR;
+        const T* ap = a + p * MR;
+        for (size_t i = 0; i < MR; ++i) {
+            T ai = ap[i];
+            for (size_t j = 0; j < NR; ++j) {
+                acc[i][j] += ai * bp[j];
+            }
+        }
+    }
+    for (size_t i = 0; i < mr; ++i) {
+        T* ci = c + i * ldc;
+        for (size_t j = 0; j < nr; ++j) {
+            ci[j] = accumulate ? ci[j] + acc[i][j] : acc[i][j];
+        }
+    }
+}
+
+template<size_t MR, size_t NR>
+inline void store_tile(const float* tile, float* c, size_t ldc, size_t mr, size_t nr, bool accumulate) {
+    for (size_t i = 0; i < mr; ++i) {
+        float* ci = c + i * ldc;
+        const float* ti = tile + i * NR;
+        for (size_t j = 0; j < nr; ++j) {
+            ci[j] = accumulate ? ci[j] + ti[j] : ti[j];
+        }
+    }
+}
+
+#ifdef UTEC_GEMM_X86
+
+constexpr size_t AVX2_MR = 6;
+constexpr size_t AVX2_NR = 16;
+
+__attribute__((target("avx2,fma")))
+inline void micro_kernel_avx2(size_t kc, const float* a, const float* b, float* c, size_t ldc,
+                              size_t mr, size_t nr, bool accumulate) {
+    __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+    __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+    __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+    __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+    __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+    __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+    for (size_t p = 0; p < kc; ++p) {
+        __m256 b0 = _mm256_loadu_ps(b);
+        __m256 b1 = _mm256_loadu_ps(b + 8);
+        __m256 av;
+        av = _mm256_broadcast_ss(a + 0); c00 = _mm256_fmadd_ps(av, b0, c00); c01 = _mm256_fmadd_ps(av, b1, c01);
+        av = _mm256_broadcast_ss(a + 1); c10 = _mm256_fmadd_ps(av, b0, c10); c11 = _mm256_fmadd_ps(av, b1, c11);
+        av = _mm256_broadcast_ss(a + 2); c20 = _mm256_fmadd_ps(av, b0, c20); c21 = _mm256_fmadd_ps(av, b1, c21);
+        av = _mm256_broadcast_ss(a + 3); c30 = _mm256_fmadd_ps(av, b0, c30); c31 = _mm256_fmadd_ps(av, b1, c31);
+        av = _mm256_broadcast_ss(a + 4); c40 = _mm256_fmadd_ps(av, b0, c40); c41 = _mm256_fmadd_ps(av, b1, c41);
+        av = _mm256_broadcast_ss(a + 5); c50 = _mm256_fmadd_ps(av, b0, c50); c51 = _mm256_fmadd_ps(av, b1, c51);
+        a += AVX2_MR;
+        b += AVX2_NR;
+    }
+
+    __m256 rows[AVX2_MR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}, {c40, c41}, {c50, c51}};
+    if (mr == AVX2_MR && nr == AVX2_NR) {
+        for (size_t i = 0; i < AVX2_MR; ++i) {
+            float* ci = c + i * ldc;
+            if (accumulate) {
+                rows[i][0] = _mm256_add_ps(rows[i][0], _mm256_loadu_ps(ci));
+                rows[i][1] = _mm256_add_ps(rows[i][1], _mm256_loadu_ps(ci + 8));
+            }
+            _mm256_storeu_ps(ci, rows[i][0]);
+            _mm256_storeu_ps(ci + 8, rows[i][1]);
+        }
+        return;
+    }
+
+    // Bloque de borde: volcar a un buffer temporal y copiar la parte válida
+    alignas(32) float tile[AVX2_MR * AVX2_NR];
+    for (size_t i = 0; i < AVX2_MR; ++i) {
+        _mm256_store_ps(tile + i * AVX2_NR, rows[i][0]);
+        _mm256_store_ps(tile + i * AVX2_NR + 8, rows[i][1]);
+    }
+    store_tile<AVX2_MR, AVX2_NR>(tile, c, ldc, mr, nr, accumulate);
+}
+
+constexpr size_t AVX512_MR = 12;
+constexpr size_t AVX512_NR = 16;
+
+__attribute__((target("avx512f")))
+inline void micro_kernel_avx512(size_t kc, const float* a, const float* b, float* c, size_t ldc,
+                                size_t mr, size_t nr, bool accumulate) {
+    __m512 acc[AVX512_MR];
+#pragma GCC unroll 12
+    for (size_t i = 0; i < AVX512_MR; ++i) acc[i] = _mm512_setzero_ps();
+
+    for (size_t p = 0; p < kc; ++p) {
+        __m512 bv = _mm512_loadu_ps(b);
+#pragma GCC unroll 12
+        for (size_t i = 0; i < AVX512_MR; ++i) {
+            acc[i] = _mm512_fmadd_ps(_mm512_set1_ps(a[i]), bv, acc[i]);
+        }
+        a += AVX512_MR;
+        b += AVX512_NR;
+    }
+
+    // Con AVX-512 los bordes en columnas se resuelven con máscaras
+    __mmask16 mask = static_cast<__mmask16>((nr >= 16) ? 0xFFFFu : ((1u << nr) - 1u));
+    for (size_t i = 0; i < mr; ++i) {
+        float* ci = c + i * ldc;
+        __m512 v = acc[i];
+        if (accumulate) {
+            v = _mm512_add_ps(v, _mm512_maskz_loadu_ps(mask, ci));
+        }
+        _mm512_mask_storeu_ps(ci, mask, v);
+    }
+}
+
+#endif // UTEC_GEMM_X86
+
+// Los operandos se describen con un paso por fila (rs) y otro por columna
+// (cs): el elemento (i, j) está en ptr[i * rs + j * cs]. Así una matriz
+// transpuesta se lee sin copiarla, intercambiando los pasos; el
+// empaquetado absorbe el cambio de orden.
+
+// Empaqueta un bloque kc x nc de B en paneles contiguos de kc x NR,
+// rellenando con ceros las columnas que sobran en el último panel.
+template<typename T>
+void pack_b(size_t kc, size_t nc, const T* b, size_t rs, size_t cs, size_t NR, T* out) {
+    for (size_t j = 0; j < nc; j += NR) {
+        size_t nr = std::min(NR, nc - j);
+        for (size_t p = 0; p < kc; ++p) {
+            const T* src = b + p * rs + j * cs;
+            size_t q = 0;
+            if (cs == 1) {
+                for (; q < nr; ++q) out[q] = src[q];
+            } else {
+                for (; q < nr; ++q) out[q] = src[q * cs];
+            }
+            for (; q < NR; ++q) out[q] = T{};
+            out += NR;
+        }
+    }
+}
+
+// Empaqueta un bloque mc x kc de A en paneles de MR filas intercaladas por k.
+template<typename T>
+void pack_a(size_t mc, size_t kc, const T* a, size_t rs, size_t cs, size_t MR, T* out) {
+    for (size_t i = 0; i < mc; i += MR) {
+        size_t mr = std::min(MR, mc - i);
+        for (size_t p = 0; p < kc; ++p) {
+            const T* src = a + i * rs + p * cs;
+            size_t r = 0;
+            if (rs == 1) {
+                for (; r < mr; ++r) out[r] = src[r];
+            } else {
+                for (; r < mr; ++r) out[r] = src[r * rs];
+            }
+            for (; r < MR; ++r) out[r] = T{};
+            out += MR;
+        }
+    }
+}
+
+// Aplica el epílogo a un bloque rows x cols de C que empieza en la columna
+// col0 de la matriz completa
+template<typename T>
+void apply_epilogue(const Epilogue<T>& epilogue, T* c, size_t ldc, size_t rows, size_t cols, size_t col0) {
+    if (epilogue.bias) {
+        const T* bias = epilogue.bias + col0;
+        for (size_t i = 0; i < rows; ++i) {
+            T* ci = c + i * ldc;
+            for (size_t j = 0; j < cols; ++j) ci[j] += bias[j];
+        }
+    }
+    if (epilogue.activation) {
+        if (ldc == cols) {
+            epilogue.activation(c, c, rows * cols);
+        } else {
+            for (size_t i = 0; i < rows; ++i) epilogue.activation(c + i * ldc, c + i * ldc, cols);
+        }
+    }
+}
+
+template<typename T>
+void gemm_blocked(size_t m, size_t n, size_t k,
+                  const T* a, size_t a_rs, size_t a_cs,
+                  const T* b, size_t b_rs, size_t b_cs,
+                  T* c, size_t ldc,
+                  size_t MR, size_t NR, MicroKernel<T> kernel,
+                  const Epilogue<T>& epilogue) {
+    thread_local std::vector<T> a_pack;
+    thread_local std::vector<T> b_pack;
+
+    const size_t mc_max = (MC + MR - 1) / MR * MR;
+    for (size_t jc = 0; jc < n; jc += NC) {
+        size_t nc = std::min(NC, n - jc);
+        size_t nc_padded = (nc + NR - 1) / NR * NR;
+        for (size_t pc = 0; pc < k; pc += KC) {
+            size_t kc = std::min(KC, k - pc);
+            b_pack.resize(nc_padded * kc);
+            pack_b(kc, nc, b + pc * b_rs + jc * b_cs, b_rs, b_cs, NR, b_pack.data());
+
+            for (size_t ic = 0; ic < m; ic += mc_max) {
+                size_t mc = std::min(mc_max, m - ic);
+                size_t mc_padded = (mc + MR - 1) / MR * MR;
+                a_pack.resize(mc_padded * kc);
+                pack_a(mc, kc, a + ic * a_rs + pc * a_cs, a_rs, a_cs, MR, a_pack.data());
+
+                for (size_t jr = 0; jr < nc; jr += NR) {
+                    const T* bp = b_pack.data() + jr * kc;
+                    size_t nr = std::min(NR, nc - jr);
+                    for (size_t ir = 0; ir < mc; ir += MR) {
+                        const T* ap = a_pack.data() + ir * kc;
+                        size_t mr = std::min(MR, mc - ir);
+                        kernel(kc, ap, bp, c + (ic + ir) * ldc + jc + jr, ldc, mr, nr, pc > 0);
+                    }
+                }
+
+                // Bloque mc x nc terminado (último tramo de k): epílogo en caché
+                if (pc + kc == k && !epilogue.empty()) {
+                    apply_epilogue(epilogue, c + ic * ldc + jc, ldc, mc, nc, jc);
+                }
+            }
+        }
+    }
+}
+
+// Filas [ic, ic + mc) de C = A * B con N columnas fijas (A sin transponer)
+template<typename T, size_t N>
+void narrow_rows(size_t ic, size_t mc, size_t k, const T* a, size_t a_rs,
+                 const T* b, size_t b_rs, size_t b_cs, T* c, size_t ldc) {
+    for (size_t i = ic; i < ic + mc; ++i) {
+        const T* ai = a + i * a_rs;
+        T acc[N] = {};
+        for (size_t p = 0; p < k; ++p) {
+            const T* bp = b + p * b_rs;
+            for (size_t j = 0; j < N; ++j) {
+                acc[j] += ai[p] * bp[j * b_cs];
+            }
+        }
+        std::copy_n(acc, N, c + i * ldc);
+    }
+}
+
+// Matrices muy angostas (p.ej. la capa de salida 16 -> 1): un producto punto
+// por fila es más barato que rellenar un panel de NR columnas con ceros.
+// Cada fila acumula en registros (n < 4), sin ir y volver a C por cada p,
+// y el epílogo se aplica por tramos de MC filas recién calculadas. Si A está
+// transpuesta se recorre k por fuera para leerla en orden.
+template<typename T>
+void gemm_narrow(size_t m, size_t n, size_t k,
+                 const T* a, size_t a_rs, size_t a_cs,
+                 const T* b, size_t b_rs, size_t b_cs,
+                 T* c, size_t ldc, const Epilogue<T>& epilogue) {
+    if (a_cs == 1) {
+        for (size_t ic = 0; ic < m; ic += MC) {
+            size_t mc = std::min(MC, m - ic);
+            switch (n) {
+                case 1:  narrow_rows<T, 1>(ic, mc, k, a, a_rs, b, b_rs, b_cs, c, ldc); break;
+                case 2:  narrow_rows<T, 2>(ic, mc, k, a, a_rs, b, b_rs, b_cs, c, ldc); break;
+                default: narrow_rows<T, 3>(ic, mc, k, a, a_rs, b, b_rs, b_cs, c, ldc); break;
+            }
+            if (!epilogue.empty()) apply_epilogue(epilogue, c + ic * ldc, ldc, mc, n, 0);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < m; ++i) {
+        std::fill(c + i * ldc, c + i * ldc + n, T{});
+    }
+    for (size_t p = 0; p < k; ++p) {
+        const T* ap = a + p * a_cs;
+        const T* bp = b + p * b_rs;
+        for (size_t i = 0; i < m; ++i) {
+            T aip = ap[i * a_rs];
+            T* ci = c + i * ldc;
+            for (size_t j = 0; j < n; ++j) {
+                ci[j] += aip * bp[j * b_cs];
+            }
+        }
+    }
+    if (!epilogue.empty()) apply_epilogue(epilogue, c, ldc, m, n, 0);
+}
+
+} // namespace detail
+
+// Fuerza un conjunto de instrucciones (para benchmarks y pruebas). Si la CPU
+// no lo soporta se usa el mejor disponible.
+inline void force_isa(Isa isa) {
+    Isa best = detected_isa();
+    detail::forced_isa() = (static_cast<int>(isa) <= static_cast<int>(best)) ? isa : best;
+}
+
+inline Isa active_isa() {
+    return detail::forced_isa();
+}
+
+enum class Op { none, transpose };
+
+// C[m x n] = op(A)[m x k] * op(B)[k x n]. A, B y C se guardan en row-major
+// con leading dimensions lda, ldb y ldc; op() indica si el operando se lee
+// transpuesto (en ese caso A se guarda como k x m y B como n x k). El
+// epílogo, si se indica, se aplica a C dentro del mismo recorrido.
+template<typename T>
+void gemm(Op op_a, Op op_b, size_t m, size_t n, size_t k,
+          const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc,
+          const Epilogue<T>& epilogue = {}) {
+    if (m == 0 || n == 0) return;
+    if (k == 0) {
+        for (size_t i = 0; i < m; ++i) std::fill(c + i * ldc, c + i * ldc + n, T{});
+        if (!epilogue.empty()) detail::apply_epilogue(epilogue, c, ldc, m, n, 0);
+        return;
+    }
+
+    const size_t a_rs = (op_a == Op::none) ? lda : 1;
+    const size_t a_cs = (op_a == Op::none) ? 1 : lda;
+    const size_t b_rs = (op_b == Op::none) ? ldb : 1;
+    const size_t b_cs = (op_b == Op::none) ? 1 : ldb;
+
+    if (n < 4) {
+        detail::gemm_narrow(m, n, k, a, a_rs, a_cs, b, b_rs, b_cs, c, ldc, epilogue);
+        return;
+    }
+
+    if constexpr (std::is_same_v<T, float>) {
+#ifdef UTEC_GEMM_X86
+        switch (active_isa()) {
+            case Isa::avx512:
+                detail::gemm_blocked<float>(m, n, k, a, a_rs, a_cs, b, b_rs, b_cs, c, ldc,
+                                            detail::AVX512_MR, detail::AVX512_NR, detail::micro_kernel_avx512,
+                                            epilogue);
+                return;
+            case Isa::avx2:
+                detail::gemm_blocked<float>(m, n, k, a, a_rs, a_cs, b, b_rs, b_cs, c, ldc,
+                                            detail::AVX2_MR, detail::AVX2_NR, detail::micro_kernel_avx2,
+                                            epilogue);
+                return;
+            default:
+                break;
+        }
+#endif
+    }
+    detail::gemm_blocked<T>(m, n, k, a, a_rs, a_cs, b, b_rs, b_cs, c, ldc,
+                            4, 8, detail::micro_kernel_scalar<T, 4, 8>, epilogue);
+}
+
+// C[m x n] = A[m x k] * B[k x n] sin transposiciones
+template<typename T>
+void gemm(size_t m, size_t n, size_t k,
+          const T* a, size_t lda, const T* b, size_t ldb, T* c, size_t ldc,
+          const Epilogue<T>& epilogue = {}) {
+    gemm<T>(Op::none, Op::none, m, n, k, a, lda, b, ldb, c, ldc, epilogue);
+}
+
+} // namespace gemm
+} // namespace algebra
+} // namespace utec
+
+#endif // NN_GEMM_H
@@ -2,219 +2,577 @@
 #define NN_NETWORK_H
 
 #include "tensor.h"
+#include "thread_pool.h"
+#include "workspace.h"
+#include "serialization.h"
+#include "activation.h"
+#include "optimizer.h"
+#include "dataset.h"
+#include "profiler.h"
+#include "random.h"
 #include <vector>
+#include <array>
 #include <memory>
 #include <string>
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
-#include <random>
 #include <iostream>
+#include <numeric>
+#include <thread>
 
 namespace utec {
 namespace neural_network {
 
-// Funciones de activación
 template<typename T>
-class ActivationFunction {
-public:
-    virtual ~ActivationFunction() = default;
-    virtual T forward(T x) const = 0;
-    virtual T backward(T x) const = 0;
-    virtual std::string name() const = 0;
-};
-
-template<typename T>
-class ReLU : public ActivationFunction<T> {
-public:
-    T forward(T x) const override {
-        return std::max(T{0}, x);
-    }
-    
-    T backward(T x) const override {
-        return x > T{0} ? T{1} : T{0};
-    }
-    
-    std::string name() const override { return "relu"; }
-};
-
-template<typename T>
-class Tanh : public ActivationFunction<T> {
-public:
-    T forward(T x) const override {
-        return std::tanh(x);
-    }
-    
-    T backward(T x) const override {
-        T tanh_x = std::tanh(x);
-        return T{1} - tanh_x * tanh_x;
-    }
-    
-    std::string name() const override { return "tanh"; }
-};
-
-template<typename T>
-class Sigmoid : public ActivationFunction<T> {
-public:
-    T forward(T x) const override {
-        return T{1} / (T{1} + std::exp(-x));
-    }
-    
-    T backward(T x) const override {
-        T sig_x = forward(x);
-        return sig_x * (T{1} - sig_x);
-    }
-    
-    std::string name() const override { return "sigmoid"; }
-};
+class DenseLayer;
 
 // Capas de la red neuronal
 template<typename T>
 class Layer {
 public:
+    using View = utec::algebra::MatrixView<T>;
+    using ConstView = utec::algebra::MatrixView<const T>;
+
     virtual ~Layer() = default;
     virtual utec::algebra::Tensor<T, 2> forward(const utec::algebra::Tensor<T, 2>& input) = 0;
     virtual utec::algebra::Tensor<T, 2> backward(const utec::algebra::Tensor<T, 2>& grad_output) = 0;
-    virtual void update_weights(T learning_rate) {}
     virtual std::string type() const = 0;
+
+    // Camino sin asignaciones del entrenamiento: escriben en vistas del
+    // workspace de la red. forward_into recuerda la vista de entrada (no la
+    // copia), que debe seguir viva hasta backward_into. Si grad_input está
+    // vacía no se calcula el gradiente de la entrada (primera capa).
+    virtual void forward_into(ConstView input, View output) = 0;
+    virtual void backward_into(ConstView grad_output, View grad_input) = 0;
+
+    // Columnas de salida para una entrada de input_size columnas
+    virtual size_t output_size(size_t input_size) const { return input_size; }
+
+    // true si forward_into puede escribir sobre su propia entrada (la red
+    // reutiliza entonces el mismo trozo del workspace)
+    virtual bool in_place() const { return false; }
+
+    // true si backward_into lee la salida de forward_into: entonces la capa
+    // siguiente no puede escribir encima aunque sea in_place
+    virtual bool reads_output() const { return false; }
+
+    // Fusión de capas: si esta capa sigue a `dense`, devuelve una capa que
+    // ejecuta ambas en un solo recorrido (comparte los pesos de dense), o
+    // nullptr si no se puede fusionar.
+    virtual std::unique_ptr<Layer<T>> fuse_after(DenseLayer<T>& /*dense*/) const { return nullptr; }
+
+    // Sólo inferencia: escribe el resultado en output reutilizando su
+    // memoria y no guarda nada para backward.
+    virtual void infer(const utec::algebra::Tensor<T, 2>& input, utec::algebra::Tensor<T, 2>& output) {
+        output = forward(input);
+    }
+
+    // Copia independiente de la capa (réplicas para entrenamiento en paralelo)
+    virtual std::unique_ptr<Layer<T>> clone() const = 0;
+
+    // Parámetros entrenables y sus gradientes, en el mismo orden. La red
+    // los reúne en dos buffers contiguos: declara sus formas con
+    // parameter_shapes y entrega a la capa vistas a esos buffers con
+    // bind_parameters (la capa copia ahí sus valores actuales).
+    virtual std::vector<std::array<size_t, 2>> parameter_shapes() const { return {}; }
+    virtual void bind_parameters(const std::vector<View>&, const std::vector<View>&) {}
+    virtual std::vector<View> parameters() { return {}; }
+    virtual std::vector<View> gradients() { return {}; }
 };
 
 template<typename T>
 class DenseLayer : public Layer<T> {
 private:
-    utec::algebra::Tensor<T, 2> weights_;
-    utec::algebra::Tensor<T, 2> biases_;
-    utec::algebra::Tensor<T, 2> last_input_;
-    utec::algebra::Tensor<T, 2> weight_gradients_;
-    utec::algebra::Tensor<T, 2> bias_gradients_;
-    
+    using View = typename Layer<T>::View;
+    using ConstView = typename Layer<T>::ConstView;
+
+    size_t input_size_;
+    size_t output_size_;
+
+    // Pesos, biases y sus gradientes: vistas a los buffers de parámetros de
+    // la red (bind_parameters) o a owned_ si la capa se usa por separado
+    View weights_;
+    View biases_;
+    View weight_gradients_;
+    View bias_gradients_;
+    std::vector<T> owned_;
+
+    utec::algebra::Tensor<T, 2> last_input_;   // copia para forward() por valor
+    ConstView input_;                          // entrada del último forward
+
+    // Pesos prestados de un modelo mapeado en memoria (NeuralNetwork::load).
+    // storage mantiene vivo el mapeo; al entrenar se copian a weights_.
+    std::shared_ptr<const void> storage_;
+    const T* mapped_weights_ = nullptr;
+    const T* mapped_biases_ = nullptr;
+
+    // Apunta las vistas a owned_: pesos, biases y sus gradientes seguidos
+    void point_to_owned() {
+        T* p = owned_.data();
+        const size_t w = input_size_ * output_size_;
+        weights_ = {p, input_size_, output_size_};
+        biases_ = {p + w, 1, output_size_};
+        weight_gradients_ = {p + w + output_size_, input_size_, output_size_};
+        bias_gradients_ = {p + 2 * w + output_size_, 1, output_size_};
+    }
+
+    // Copia los pesos prestados a memoria propia (antes de modificarlos)
+    void materialize() {
+        if (mapped_weights_) {
+            owned_.assign(2 * (input_size_ + 1) * output_size_, T{0});
+            point_to_owned();
+            std::copy_n(mapped_weights_, weights_.size(), weights_.data);
+            std::copy_n(mapped_biases_, biases_.size(), biases_.data);
+            mapped_weights_ = nullptr;
+            mapped_biases_ = nullptr;
+            storage_.reset();
+        }
+    }
+
 public:
     DenseLayer(size_t input_size, size_t output_size) 
-        : weights_(input_size, output_size), biases_(1, output_size) {
+        : input_size_(input_size), output_size_(output_size),
+          owned_(2 * (input_size + 1) * output_size, T{0}) {
+        point_to_owned();
         
-        // Inicialización Xavier
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        // Inicialización Xavier con un flujo propio del generador global
+        auto rng = utec::random::next_stream();
         T limit = std::sqrt(T{6} / (input_size + output_size));
-        std::uniform_real_distribution<T> dis(-limit, limit);
         
         for (size_t i = 0; i < input_size; ++i) {
             for (size_t j = 0; j < output_size; ++j) {
-                weights_(i, j) = dis(gen);
+                weights_(i, j) = utec::random::uniform(rng, -limit, limit);
             }
         }
-        
-        biases_.fill(T{0});
     }
+
+    // Capa con pesos prestados (input_size x output_size) y biases
+    // (output_size) que viven en storage; no se copian hasta entrenar.
+    DenseLayer(size_t input_size, size_t output_size, std::shared_ptr<const void> storage,
+               const T* weights, const T* biases)
+        : input_size_(input_size), output_size_(output_size), storage_(std::move(storage)),
+          mapped_weights_(weights), mapped_biases_(biases) {}
+
+    // La copia comparte las vistas a los buffers de la red (si la capa está
+    // enlazada) o duplica owned_
+    DenseLayer(const DenseLayer& other)
+        : Layer<T>(other), input_size_(other.input_size_), output_size_(other.output_size_),
+          weights_(other.weights_), biases_(other.biases_),
+          weight_gradients_(other.weight_gradients_), bias_gradients_(other.bias_gradients_),
+          owned_(other.owned_), last_input_(other.last_input_), input_(other.input_),
+          storage_(other.storage_), mapped_weights_(other.mapped_weights_), mapped_biases_(other.mapped_biases_) {
+        if (!owned_.empty()) {
+            point_to_owned();
+        }
+    }
+
+    DenseLayer& operator=(const DenseLayer&) = delete;
     
     utec::algebra::Tensor<T, 2> forward(const utec::algebra::Tensor<T, 2>& input) override {
         last_input_ = input;
-        
-        // output = input * weights + biases
-        auto output = input.matmul(weights_);
-        
-        // Agregar bias a cada fila
-        for (size_t i = 0; i < output.shape()[0]; ++i) {
-            for (size_t j = 0; j < output.shape()[1]; ++j) {
-                output(i, j) += biases_(0, j);
-            }
-        }
-        
+        utec::algebra::Tensor<T, 2> output(input.shape()[0], output_size_);
+        forward_into(last_input_.view(), output.view());
         return output;
     }
+
+    void forward_into(ConstView input, View output) override {
+        PROFILE_ZONE("DenseLayer::forward");
+        forward_with(input, output, nullptr);
+    }
+
+    void infer(const utec::algebra::Tensor<T, 2>& input, utec::algebra::Tensor<T, 2>& output) override {
+        infer_with(input, output, nullptr);
+    }
+
+    // output = activation(input * weights + biases); el bias y la activación
+    // se aplican en el epílogo del GEMM (activation puede ser nula)
+    void forward_with(ConstView input, View output, typename utec::algebra::gemm::Epilogue<T>::Activation activation) {
+        input_ = input;
+        utec::algebra::gemm::gemm<T>(input.rows, output.cols, input.cols,
+                                     input.data, input.cols,
+                                     weights(), output_size_,
+                                     output.data, output.cols, {biases(), activation});
+    }
+
+    void infer_with(const utec::algebra::Tensor<T, 2>& input, utec::algebra::Tensor<T, 2>& output,
+                    typename utec::algebra::gemm::Epilogue<T>::Activation activation) const {
+        if (input.shape()[1] != input_size_) {
+            throw std::invalid_argument("Invalid dimensions for matrix multiplication");
+        }
+        output.resize(input.shape()[0], output_size_);
+        utec::algebra::gemm::gemm<T>(input.shape()[0], output_size_, input_size_,
+                                     input.data(), input_size_, weights(), output_size_,
+                                     output.data(), output_size_, {biases(), activation});
+    }
     
     utec::algebra::Tensor<T, 2> backward(const utec::algebra::Tensor<T, 2>& grad_output) override {
-        // Calcular gradientes de los pesos
-        weight_gradients_ = last_input_.transpose().matmul(grad_output);
-        
-        // Calcular gradientes de los biases
-        bias_gradients_ = utec::algebra::Tensor<T, 2>(1, grad_output.shape()[1]);
-        for (size_t j = 0; j < grad_output.shape()[1]; ++j) {
-            T sum = T{0};
-            for (size_t i = 0; i < grad_output.shape()[0]; ++i) {
-                sum += grad_output(i, j);
+        utec::algebra::Tensor<T, 2> grad_input(grad_output.shape()[0], input_size_);
+        backward_into(grad_output.view(), grad_input.view());
+        return grad_input;
+    }
+
+    void backward_into(ConstView grad_output, View grad_input) override {
+        PROFILE_ZONE("DenseLayer::backward");
+        const size_t rows = grad_output.rows;
+        const size_t out = output_size_;
+
+        // Calcular gradientes de los biases (suma por columnas)
+        T* bias_grad = bias_gradient_data();
+        std::fill(bias_grad, bias_grad + out, T{0});
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < out; ++j) {
+                bias_grad[j] += grad_output(i, j);
             }
-            bias_gradients_(0, j) = sum;
         }
-        
-        // Calcular gradientes para la capa anterior
-        return grad_output.matmul(weights_.transpose());
+
+        backward_weights(grad_output, grad_input);
     }
-    
-    void update_weights(T learning_rate) override {
-        // Actualizar pesos
-        for (size_t i = 0; i < weights_.shape()[0]; ++i) {
-            for (size_t j = 0; j < weights_.shape()[1]; ++j) {
-                weights_(i, j) -= learning_rate * weight_gradients_(i, j);
-            }
+
+    // Gradientes de los pesos y de la entrada a partir de grad_output (el
+    // de los biases lo calcula quien llama, ver bias_gradient_data)
+    void backward_weights(ConstView grad_output, View grad_input) {
+        namespace gemm = utec::algebra::gemm;
+        const size_t rows = grad_output.rows;
+        const size_t in = input_size_;
+        const size_t out = output_size_;
+        materialize();
+
+        // Calcular gradientes de los pesos: input^T * grad_output
+        gemm::gemm<T>(gemm::Op::transpose, gemm::Op::none, in, out, rows,
+                      input_.data, input_.cols, grad_output.data, grad_output.cols,
+                      weight_gradients_.data, out);
+
+        // Calcular gradientes para la capa anterior: grad_output * weights^T
+        if (!grad_input.empty()) {
+            gemm::gemm<T>(gemm::Op::none, gemm::Op::transpose, rows, in, out,
+                          grad_output.data, grad_output.cols, weights_.data, out,
+                          grad_input.data, grad_input.cols);
         }
-        
-        // Actualizar biases
-        for (size_t j = 0; j < biases_.shape()[1]; ++j) {
-            biases_(0, j) -= learning_rate * bias_gradients_(0, j);
+    }
+
+    T* bias_gradient_data() {
+        materialize();
+        return bias_gradients_.data;
+    }
+
+    size_t output_size(size_t input_size) const override {
+        if (input_size != input_size_) {
+            throw std::invalid_argument("Input size does not match dense layer");
         }
+        return output_size_;
     }
     
     std::string type() const override { return "dense"; }
+
+    std::unique_ptr<Layer<T>> clone() const override {
+        return std::make_unique<DenseLayer<T>>(*this);
+    }
+
+    std::vector<std::array<size_t, 2>> parameter_shapes() const override {
+        return {{input_size_, output_size_}, {1, output_size_}};
+    }
+
+    void bind_parameters(const std::vector<View>& parameters, const std::vector<View>& gradients) override {
+        // Una réplica ya apunta a los parámetros de la red: no hay qué copiar
+        if (parameters[0].data != weights()) {
+            std::copy_n(weights(), parameters[0].size(), parameters[0].data);
+            std::copy_n(biases(), parameters[1].size(), parameters[1].data);
+        }
+        weights_ = parameters[0];
+        biases_ = parameters[1];
+        weight_gradients_ = gradients[0];
+        bias_gradients_ = gradients[1];
+        owned_ = {};
+        mapped_weights_ = nullptr;
+        mapped_biases_ = nullptr;
+        storage_.reset();
+    }
+
+    std::vector<View> parameters() override {
+        materialize();
+        return {weights_, biases_};
+    }
+
+    std::vector<View> gradients() override {
+        materialize();
+        return {weight_gradients_, bias_gradients_};
+    }
+
+    // true si los pesos se leen directamente de un modelo mapeado
+    bool borrows_weights() const { return mapped_weights_ != nullptr; }
+
+    // Pesos (input_size x output_size, row-major) y biases, propios o prestados
+    const T* weights() const { return mapped_weights_ ? mapped_weights_ : weights_.data; }
+    const T* biases() const { return mapped_biases_ ? mapped_biases_ : biases_.data; }
+    size_t input_size() const { return input_size_; }
+    size_t output_size() const { return output_size_; }
 };
 
-template<typename T>
-class ActivationLayer : public Layer<T> {
+// Dense seguida de una activación en un solo recorrido: el GEMM suma el
+// bias y aplica la activación a cada bloque de la salida mientras está en
+// caché, y backward calcula la derivada de la activación y el gradiente de
+// los biases en la misma pasada. Los pesos y sus gradientes siguen siendo
+// los de la DenseLayer original (la creada por NeuralNetwork al fusionar).
+template<typename T, template<typename> class Activation>
+class FusedDenseLayer : public Layer<T> {
 private:
-    std::unique_ptr<ActivationFunction<T>> activation_;
-    utec::algebra::Tensor<T, 2> last_input_;
-    
+    using View = typename Layer<T>::View;
+    using ConstView = typename Layer<T>::ConstView;
+    using Function = Activation<T>;
+
+    // Filas por tramo de backward (delta del tramo queda en L1)
+    static constexpr size_t block_rows = 64;
+
+    DenseLayer<T>& dense_;
+    utec::algebra::Tensor<T, 2> last_input_;   // copias para forward() por valor
+    utec::algebra::Tensor<T, 2> last_output_;
+    ConstView output_;                         // salida del último forward
+    utec::algebra::Tensor<T, 2> delta_;        // gradiente antes de la activación
+
+    static void activate(const T* in, T* out, size_t n) { Function::forward(in, out, n); }
+
 public:
-    ActivationLayer(const std::string& activation_name) {
-        if (activation_name == "relu") {
-            activation_ = std::make_unique<ReLU<T>>();
-        } else if (activation_name == "tanh") {
-            activation_ = std::make_unique<Tanh<T>>();
-        } else if (activation_name == "sigmoid") {
-            activation_ = std::make_unique<Sigmoid<T>>();
-        } else {
-            throw std::invalid_argument("Unknown activation function: " + activation_name);
+    explicit FusedDenseLayer(DenseLayer<T>& dense) : dense_(dense) {}
+
+    utec::algebra::Tensor<T, 2> forward(const utec::algebra::Tensor<T, 2>& input) override {
+        last_input_ = input;
+        last_output_.resize(input.shape()[0], output_size(input.shape()[1]));
+        forward_into(last_input_.view(), last_output_.view());
+        return last_output_;
+    }
+
+    void forward_into(ConstView input, View output) override {
+        PROFILE_ZONE("FusedDenseLayer::forward");
+        dense_.forward_with(input, output, &FusedDenseLayer::activate);
+        output_ = output;
+    }
+
+    void infer(const utec::algebra::Tensor<T, 2>& input, utec::algebra::Tensor<T, 2>& output) override {
+        dense_.infer_with(input, output, &FusedDenseLayer::activate);
+    }
+
+    utec::algebra::Tensor<T, 2> backward(const utec::algebra::Tensor<T, 2>& grad_output) override {
+        utec::algebra::Tensor<T, 2> grad_input(grad_output.shape()[0], last_input_.shape()[1]);
+        backward_into(grad_output.view(), grad_input.view());
+        return grad_input;
+    }
+
+    void backward_into(ConstView grad_output, View grad_input) override {
+        PROFILE_ZONE("FusedDenseLayer::backward");
+        const size_t rows = grad_output.rows;
+        const size_t cols = grad_output.cols;
+        delta_.resize(rows, cols);
+        T* delta = delta_.data();
+
+        // delta = grad_output * f'(salida) y su suma por columnas, por tramos
+        T* bias_grad = dense_.bias_gradient_data();
+        std::fill(bias_grad, bias_grad + cols, T{0});
+        for (size_t begin = 0; begin < rows; begin += block_rows) {
+            size_t count = std::min(block_rows, rows - begin) * cols;
+            size_t offset = begin * cols;
+            Function::backward(grad_output.data + offset, output_.data + offset, delta + offset, count);
+            for (size_t i = 0; i < count; i += cols) {
+                for (size_t j = 0; j < cols; ++j) {
+                    bias_grad[j] += delta[offset + i + j];
+                }
+            }
         }
+
+        dense_.backward_weights(delta_.view(), grad_input);
     }
+
+    size_t output_size(size_t input_size) const override { return dense_.output_size(input_size); }
+    bool reads_output() const override { return true; }
+
+    std::string type() const override { return dense_.type() + "+activation_" + Function::name(); }
+
+    // Las capas fusionadas se vuelven a crear a partir de las originales
+    std::unique_ptr<Layer<T>> clone() const override {
+        throw std::logic_error("Fused layers cannot be cloned");
+    }
+};
+
+// Capa de activación elemento a elemento. Activation es una política de
+// activation.h (ReLU, Tanh, Sigmoid): sin llamadas virtuales por elemento.
+// Guarda la vista de su salida, de la que se obtiene la derivada.
+template<typename T, template<typename> class Activation>
+class ActivationLayer : public Layer<T> {
+private:
+    using View = typename Layer<T>::View;
+    using ConstView = typename Layer<T>::ConstView;
+    using Function = Activation<T>;
+
+    utec::algebra::Tensor<T, 2> last_output_;  // copia para backward() por valor
+    ConstView output_;                         // salida del último forward
     
+public:
     utec::algebra::Tensor<T, 2> forward(const utec::algebra::Tensor<T, 2>& input) override {
-        last_input_ = input;
-        return input.apply([this](T x) { return activation_->forward(x); });
+        last_output_.resize(input.shape()[0], input.shape()[1]);
+        forward_into(input.view(), last_output_.view());
+        return last_output_;
+    }
+
+    // input y output pueden ser la misma memoria
+    void forward_into(ConstView input, View output) override {
+        PROFILE_ZONE("ActivationLayer::forward");
+        Function::forward(input.data, output.data, input.size());
+        output_ = output;
+    }
+
+    void infer(const utec::algebra::Tensor<T, 2>& input, utec::algebra::Tensor<T, 2>& output) override {
+        output.resize(input.shape()[0], input.shape()[1]);
+        Function::forward(input.data(), output.data(), input.size());
     }
     
     utec::algebra::Tensor<T, 2> backward(const utec::algebra::Tensor<T, 2>& grad_output) override {
-        auto grad_input = last_input_.apply([this](T x) { return activation_->backward(x); });
-        
-        // Element-wise multiplication
-        utec::algebra::Tensor<T, 2> result(grad_output.shape()[0], grad_output.shape()[1]);
-        for (size_t i = 0; i < grad_output.shape()[0]; ++i) {
-            for (size_t j = 0; j < grad_output.shape()[1]; ++j) {
-                result(i, j) = grad_output(i, j) * grad_input(i, j);
-            }
-        }
-        
-        return result;
+        utec::algebra::Tensor<T, 2> grad_input(grad_output.shape()[0], grad_output.shape()[1]);
+        backward_into(grad_output.view(), grad_input.view());
+        return grad_input;
+    }
+
+    void backward_into(ConstView grad_output, View grad_input) override {
+        if (grad_input.empty()) return;
+        PROFILE_ZONE("ActivationLayer::backward");
+        Function::backward(grad_output.data, output_.data, grad_input.data, grad_output.size());
+    }
+
+    bool in_place() const override { return true; }
+    bool reads_output() const override { return true; }
+
+    std::unique_ptr<Layer<T>> fuse_after(DenseLayer<T>& dense) const override {
+        return std::make_unique<FusedDenseLayer<T, Activation>>(dense);
     }
     
-    std::string type() const override { return "activation_" + activation_->name(); }
+    std::string type() const override { return "activation_" + Function::name(); }
+
+    std::unique_ptr<Layer<T>> clone() const override {
+        return std::make_unique<ActivationLayer<T, Activation>>();
+    }
 };
 
+// Crea la capa de activación por nombre ("relu", "tanh", "sigmoid")
+template<typename T>
+std::unique_ptr<Layer<T>> make_activation_layer(const std::string& activation_name) {
+    if (activation_name == "relu") {
+        return std::make_unique<ActivationLayer<T, ReLU>>();
+    } else if (activation_name == "tanh") {
+        return std::make_unique<ActivationLayer<T, Tanh>>();
+    } else if (activation_name == "sigmoid") {
+        return std::make_unique<ActivationLayer<T, Sigmoid>>();
+    }
+    throw std::invalid_argument("Unknown activation function: " + activation_name);
+}
+
 // Red neuronal completa
 template<typename T>
 class NeuralNetwork {
 private:
+    using Tensor2 = utec::algebra::Tensor<T, 2>;
+    using View = utec::algebra::MatrixView<T>;
+    using ConstView = utec::algebra::MatrixView<const T>;
+
+    // Memoria de un paso de entrenamiento dentro de un Workspace: entrada y
+    // objetivos del mini-batch (o shard), la salida de cada capa y dos
+    // buffers de gradiente que se alternan durante backward.
+    struct Buffers {
+        Workspace<T> arena;
+        size_t rows = 0;            // filas planificadas
+        size_t input_cols = 0;
+        size_t target_cols = 0;
+        size_t input = 0;
+        size_t target = 0;
+        std::vector<size_t> activations;
+        size_t gradients[2] = {0, 0};
+    };
+
+    // Orden de ejecución de un conjunto de capas tras la pasada de fusión:
+    // steps apunta a las capas originales o a las fusionadas, que viven en
+    // fused y comparten los pesos de las originales.
+    struct Plan {
+        std::vector<std::unique_ptr<Layer<T>>> fused;
+        std::vector<Layer<T>*> steps;
+    };
+
+    // Réplica de las capas para un hilo de entrenamiento: procesa un trozo
+    // (shard) del mini-batch y deja sus gradientes para la reducción. Lee
+    // los parámetros directamente del buffer de la red; el worker 0 escribe
+    // sus gradientes en el de la red y los demás en el suyo.
+    struct Worker {
+        std::vector<std::unique_ptr<Layer<T>>> layers;
+        Plan plan;
+        Workspace<T> gradients;
+        Buffers buffers;
+        T loss = T{0};
+    };
+
+    // Filas de un par de tensores X, y con la interfaz de ChunkedDataset
+    // (train acepta ambos)
+    struct TensorSamples {
+        const Tensor2& X;
+        const Tensor2& y;
+
+        size_t rows() const { return X.shape()[0]; }
+        size_t input_cols() const { return X.shape()[1]; }
+        size_t target_cols() const { return y.shape()[1]; }
+        const T* input(size_t r) const { return X.data() + r * X.shape()[1]; }
+        const T* target(size_t r) const { return y.data() + r * y.shape()[1]; }
+        bool contiguous(ConstView& inputs, ConstView& targets) const {
+            inputs = X.view();
+            targets = y.view();
+            return true;
+        }
+    };
+
+    // Un mini-batch repartido entre los workers
+    template<typename Samples>
+    struct BatchJob {
+        const Samples* samples;
+        size_t begin;
+        size_t rows;
+        size_t shards;
+        size_t total_elements;
+    };
+
     std::vector<std::unique_ptr<Layer<T>>> layers_;
-    T learning_rate_;
-    std::string optimizer_;
+    Plan plan_;
+    bool fuse_layers_ = true;
+    std::unique_ptr<Optimizer<T>> optimizer_;
     std::string loss_function_;
+
+    // Configuración de entrenamiento por mini-batches
+    size_t batch_size_ = 0;      // 0 = batch completo
+    bool shuffle_ = true;
+    size_t num_threads_ = 1;
+    size_t min_rows_per_thread_ = 64;
+    utec::random::SplitMix64 shuffle_rng_ = utec::random::next_stream();
+    std::unique_ptr<utec::parallel::ThreadPool> pool_;
+    std::vector<Worker> workers_;
+
+    // Estado reutilizado entre mini-batches y épocas
+    Buffers buffers_;
+
+    // Parámetros de todas las capas y sus gradientes, en dos buffers
+    // contiguos con la misma disposición (un trozo alineado por tensor); las
+    // capas guardan vistas a ellos. Optimizador, reducción entre hilos y
+    // save() los recorren de una vez.
+    Workspace<T> parameters_;
+    Workspace<T> gradients_;
+    bool parameters_bound_ = false;
+    std::vector<size_t> order_;
+
+    // Buffers de predict_batch (se alternan entre capas)
+    Tensor2 inference_buffers_[2];
     
-    T calculate_loss(const utec::algebra::Tensor<T, 2>& predictions, 
-                    const utec::algebra::Tensor<T, 2>& targets) {
+    // La pérdida y su gradiente se normalizan por total_elements, el número
+    // de elementos del mini-batch completo, para que las contribuciones de
+    // cada shard se puedan sumar directamente.
+    T calculate_loss(ConstView predictions, ConstView targets, size_t total_elements) {
         if (loss_function_ == "mse") {
             T loss = T{0};
-            size_t total_elements = predictions.shape()[0] * predictions.shape()[1];
             
-            for (size_t i = 0; i < predictions.shape()[0]; ++i) {
-                for (size_t j = 0; j < predictions.shape()[1]; ++j) {
+            for (size_t i = 0; i < predictions.rows; ++i) {
+                for (size_t j = 0; j < predictions.cols; ++j) {
                     T diff = predictions(i, j) - targets(i, j);
                     loss += diff * diff;
                 }
@@ -226,46 +584,365 @@ private:
         throw std::invalid_argument("Unknown loss function: " + loss_function_);
     }
     
-    utec::algebra::Tensor<T, 2> calculate_loss_gradient(const utec::algebra::Tensor<T, 2>& predictions,
-                                                       const utec::algebra::Tensor<T, 2>& targets) {
+    void calculate_loss_gradient(ConstView predictions, ConstView targets, size_t total_elements, View grad) {
         if (loss_function_ == "mse") {
-            utec::algebra::Tensor<T, 2> grad(predictions.shape()[0], predictions.shape()[1]);
-            T scale = T{2} / (predictions.shape()[0] * predictions.shape()[1]);
+            T scale = T{2} / total_elements;
             
-            for (size_t i = 0; i < predictions.shape()[0]; ++i) {
-                for (size_t j = 0; j < predictions.shape()[1]; ++j) {
+            for (size_t i = 0; i < predictions.rows; ++i) {
+                for (size_t j = 0; j < predictions.cols; ++j) {
                     grad(i, j) = scale * (predictions(i, j) - targets(i, j));
                 }
             }
-            
-            return grad;
+            return;
         }
         
         throw std::invalid_argument("Unknown loss function: " + loss_function_);
     }
+
+    // Invalida réplicas, workspace y listas de parámetros (cambió la arquitectura)
+    void reset_training_state() {
+        workers_.clear();
+        plan_ = Plan{};
+        buffers_ = Buffers{};
+        parameters_bound_ = false;  // los buffers siguen vivos hasta re-enlazar
+        optimizer_->reset();
+    }
+
+    // Declara un trozo por tensor de parámetros de las capas, en orden
+    static void declare_parameters(const std::vector<std::unique_ptr<Layer<T>>>& layers, Workspace<T>& buffer) {
+        buffer.clear();
+        for (const auto& layer : layers) {
+            for (const auto& shape : layer->parameter_shapes()) {
+                buffer.add(shape[0], shape[1]);
+            }
+        }
+        buffer.allocate();
+    }
+
+    // Reúne los parámetros de las capas en parameters_/gradients_. Los
+    // buffers anteriores se reemplazan sólo después de que cada capa copió
+    // sus valores a los nuevos.
+    void bind_parameters() {
+        if (parameters_bound_) return;
+        Workspace<T> parameters, gradients;
+        declare_parameters(layers_, parameters);
+        declare_parameters(layers_, gradients);
+        size_t id = 0;
+        for (auto& layer : layers_) {
+            std::vector<View> p, g;
+            for (const auto& shape : layer->parameter_shapes()) {
+                p.push_back(parameters.slice(id, shape[0]));
+                g.push_back(gradients.slice(id, shape[0]));
+                ++id;
+            }
+            layer->bind_parameters(p, g);
+        }
+        parameters_ = std::move(parameters);
+        gradients_ = std::move(gradients);
+        parameters_bound_ = true;
+    }
+
+    // Pasada de fusión: una DenseLayer seguida de una capa que acepta
+    // fusionarse (las activaciones) se ejecuta como una sola capa
+    void build_plan(std::vector<std::unique_ptr<Layer<T>>>& layers, Plan& plan) const {
+        plan.fused.clear();
+        plan.steps.clear();
+        for (size_t l = 0; l < layers.size(); ++l) {
+            auto* dense = dynamic_cast<DenseLayer<T>*>(layers[l].get());
+            if (fuse_layers_ && dense && l + 1 < layers.size()) {
+                if (auto fused = layers[l + 1]->fuse_after(*dense)) {
+                    plan.steps.push_back(fused.get());
+                    plan.fused.push_back(std::move(fused));
+                    ++l;
+                    continue;
+                }
+            }
+            plan.steps.push_back(layers[l].get());
+        }
+    }
+
+    // Plan de la red principal (se arma al primer uso)
+    const std::vector<Layer<T>*>& steps() {
+        if (plan_.steps.empty() && !layers_.empty()) {
+            build_plan(layers_, plan_);
+        }
+        return plan_.steps;
+    }
+
+    // Planifica el workspace de las capas `layers` para mini-batches de
+    // hasta `rows` filas. Sólo reserva memoria cuando cambian las formas o
+    // hacen falta más filas, así que después de la primera época no se
+    // asigna nada. Cada worker pasa su propio plan: el de la red principal
+    // se arma al primer uso y no puede construirse desde varios hilos.
+    void plan_buffers(Buffers& b, const std::vector<Layer<T>*>& layers,
+                      size_t rows, size_t input_cols, size_t target_cols) {
+        if (rows <= b.rows && input_cols == b.input_cols && target_cols == b.target_cols &&
+            b.activations.size() == layers.size()) {
+            return;
+        }
+
+        b.arena.clear();
+        b.input = b.arena.add(rows, input_cols);
+        b.target = b.arena.add(rows, target_cols);
+        b.activations.clear();
+        size_t cols = input_cols;
+        size_t widest = input_cols;
+        const Layer<T>* previous = nullptr;
+        for (auto* layer : layers) {
+            cols = layer->output_size(cols);
+            // Las activaciones trabajan sobre la salida de la capa anterior,
+            // salvo que esa capa la necesite en backward (dos activaciones
+            // seguidas): entonces van a un trozo propio
+            if (layer->in_place() && previous && !previous->reads_output()) {
+                b.activations.push_back(b.activations.back());
+            } else {
+                b.activations.push_back(b.arena.add(rows, cols));
+            }
+            previous = layer;
+            widest = std::max(widest, cols);
+        }
+        b.gradients[0] = b.arena.add(rows, widest);
+        b.gradients[1] = b.arena.add(rows, widest);
+        b.arena.allocate();
+
+        b.rows = rows;
+        b.input_cols = input_cols;
+        b.target_cols = target_cols;
+    }
+
+    // Forward + backward sobre un conjunto de capas usando el workspace b;
+    // devuelve la pérdida
+    T forward_backward(const std::vector<Layer<T>*>& layers, Buffers& b,
+                       ConstView X, ConstView y, size_t total_elements) {
+        const size_t rows = X.rows;
+        ConstView output = X;
+        for (size_t l = 0; l < layers.size(); ++l) {
+            View next = b.arena.slice(b.activations[l], rows);
+            layers[l]->forward_into(output, next);
+            output = next;
+        }
+
+        T loss = calculate_loss(output, y, total_elements);
+
+        View grad_output = b.arena.slice(b.gradients[0], rows, output.cols);
+        calculate_loss_gradient(output, y, total_elements, grad_output);
+        for (size_t l = layers.size(); l-- > 0;) {
+            // La primera capa no necesita el gradiente de su entrada
+            View grad_input;
+            if (l > 0) {
+                size_t cols = b.arena.slice(b.activations[l - 1], rows).cols;
+                grad_input = b.arena.slice(b.gradients[(layers.size() - l) % 2], rows, cols);
+            }
+            layers[l]->backward_into(grad_output, grad_input);
+            grad_output = grad_input;
+        }
+        return loss;
+    }
+
+    // Copia las filas order_[begin, end) de samples en inputs y targets
+    template<typename Samples>
+    void gather_rows(const Samples& samples, size_t begin, size_t end, View inputs, View targets) const {
+        for (size_t r = begin; r < end; ++r) {
+            std::copy_n(samples.input(order_[r]), inputs.cols, inputs.data + (r - begin) * inputs.cols);
+            std::copy_n(samples.target(order_[r]), targets.cols, targets.data + (r - begin) * targets.cols);
+        }
+    }
+
+    // Las réplicas de capas enlazadas comparten los buffers de la red; a
+    // partir del worker 1 los gradientes se re-enlazan a uno propio
+    void prepare_workers(size_t count) {
+        if (workers_.size() != count) {
+            workers_.clear();
+            workers_.resize(count);
+        }
+        for (size_t w = 0; w < workers_.size(); ++w) {
+            Worker& worker = workers_[w];
+            if (worker.layers.size() == layers_.size()) continue;
+            worker.layers.clear();
+            for (auto& layer : layers_) {
+                worker.layers.push_back(layer->clone());
+            }
+            if (w > 0) {
+                declare_parameters(worker.layers, worker.gradients);
+                size_t id = 0;
+                for (auto& layer : worker.layers) {
+                    std::vector<View> g;
+                    for (const auto& shape : layer->parameter_shapes()) {
+                        g.push_back(worker.gradients.slice(id++, shape[0]));
+                    }
+                    layer->bind_parameters(layer->parameters(), g);
+                }
+            }
+            build_plan(worker.layers, worker.plan);
+        }
+    }
+
+    // Suma en gradients_ (donde ya escribió el worker 0) los de los demás
+    void reduce_gradients() {
+        T* acc = gradients_.data();
+        const size_t n = gradients_.size();
+        for (size_t w = 1; w < workers_.size(); ++w) {
+            const T* part = workers_[w].gradients.data();
+            for (size_t i = 0; i < n; ++i) {
+                acc[i] += part[i];
+            }
+        }
+    }
+
+    // Un shard del mini-batch en el worker s
+    template<typename Samples>
+    void run_shard(const BatchJob<Samples>& job, size_t s) {
+        size_t shard_begin = job.begin + job.rows * s / job.shards;
+        size_t shard_end = job.begin + job.rows * (s + 1) / job.shards;
+        size_t rows = shard_end - shard_begin;
+        Worker& worker = workers_[s];
+        Buffers& b = worker.buffers;
+        plan_buffers(b, worker.plan.steps, rows, job.samples->input_cols(), job.samples->target_cols());
+        View X = b.arena.slice(b.input, rows);
+        View y = b.arena.slice(b.target, rows);
+        gather_rows(*job.samples, shard_begin, shard_end, X, y);
+        worker.loss = forward_backward(worker.plan.steps, b, X, y, job.total_elements);
+    }
+
+    // Procesa un mini-batch formado por las filas order_[begin, end) y
+    // actualiza los pesos; devuelve la pérdida del mini-batch.
+    template<typename Samples>
+    T train_batch(const Samples& samples, size_t begin, size_t end) {
+        PROFILE_ZONE("NeuralNetwork::train_batch");
+        size_t rows = end - begin;
+        size_t total_elements = rows * samples.target_cols();
+        size_t shards = std::min(num_threads_, std::max<size_t>(1, rows / min_rows_per_thread_));
+
+        bind_parameters();
+
+        T loss = T{0};
+        ConstView all_X, all_y;
+        if (shards <= 1 && rows == samples.rows() && samples.contiguous(all_X, all_y)) {
+            // Batch completo (sin barajar) en memoria contigua: no hace falta copiar las filas
+            plan_buffers(buffers_, steps(), rows, samples.input_cols(), samples.target_cols());
+            loss = forward_backward(steps(), buffers_, all_X, all_y, total_elements);
+        } else if (shards <= 1) {
+            plan_buffers(buffers_, steps(), rows, samples.input_cols(), samples.target_cols());
+            View batch_X = buffers_.arena.slice(buffers_.input, rows);
+            View batch_y = buffers_.arena.slice(buffers_.target, rows);
+            gather_rows(samples, begin, end, batch_X, batch_y);
+            loss = forward_backward(steps(), buffers_, batch_X, batch_y, total_elements);
+        } else {
+            prepare_workers(shards);
+            BatchJob<Samples> job{&samples, begin, rows, shards, total_elements};
+            // Sólo dos punteros capturados: std::function no asigna memoria
+            pool_->parallel_for(shards, [this, &job](size_t s) { run_shard(job, s); });
+            reduce_gradients();
+            for (const auto& worker : workers_) {
+                loss += worker.loss;
+            }
+        }
+
+        optimizer_->step(parameters_.data(), gradients_.data(), parameters_.size());
+        return loss;
+    }
+
+    // Épocas sobre samples (TensorSamples o ChunkedDataset)
+    template<typename Samples>
+    T train_samples(const Samples& samples, int epochs, bool verbose) {
+        size_t rows = samples.rows();
+        if (rows == 0) return T{0};
+        size_t batch_size = (batch_size_ == 0 || batch_size_ > rows) ? rows : batch_size_;
+        bool full_batch = batch_size == rows;
+
+        order_.resize(rows);
+        std::iota(order_.begin(), order_.end(), size_t{0});
+        
+        T epoch_loss = T{0};
+        for (int epoch = 0; epoch < epochs; ++epoch) {
+            if (shuffle_ && !full_batch) {
+                utec::random::shuffle(order_.begin(), order_.end(), shuffle_rng_);
+            }
+
+            // Pérdida media ponderada por el tamaño de cada mini-batch
+            epoch_loss = T{0};
+            for (size_t begin = 0; begin < rows; begin += batch_size) {
+                size_t end = std::min(rows, begin + batch_size);
+                epoch_loss += train_batch(samples, begin, end) * T(end - begin);
+            }
+            epoch_loss /= T(rows);
+            
+            if (verbose && epoch % 10 == 0) {
+                std::cout << "Epoch " << epoch << ", Loss: " << epoch_loss << std::endl;
+            }
+        }
+        return epoch_loss;
+    }
     
 public:
-    NeuralNetwork() : learning_rate_(T{0.001}), optimizer_("sgd"), loss_function_("mse") {}
+    NeuralNetwork() : optimizer_(make_optimizer<T>("sgd", T{0.001})), loss_function_("mse") {}
     
     void add_dense_layer(size_t input_size, size_t output_size) {
         layers_.push_back(std::make_unique<DenseLayer<T>>(input_size, output_size));
+        reset_training_state();
     }
     
     void add_activation(const std::string& activation_name) {
-        layers_.push_back(std::make_unique<ActivationLayer<T>>(activation_name));
+        layers_.push_back(make_activation_layer<T>(activation_name));
+        reset_training_state();
     }
     
+    // "sgd", "momentum", "rmsprop" o "adam" (ver optimizer.h); el estado
+    // del optimizador anterior se descarta
     void set_optimizer(const std::string& optimizer, T learning_rate) {
-        optimizer_ = optimizer;
-        learning_rate_ = learning_rate;
+        optimizer_ = make_optimizer<T>(optimizer, learning_rate);
     }
+
+    const Optimizer<T>& optimizer() const { return *optimizer_; }
     
     void set_loss_function(const std::string& loss_function) {
         loss_function_ = loss_function;
     }
+
+    // Tamaño del mini-batch (0 = batch completo) y barajado por época
+    void set_batch_size(size_t batch_size, bool shuffle = true) {
+        batch_size_ = batch_size;
+        shuffle_ = shuffle;
+    }
+
+    // Hilos para calcular los gradientes de cada mini-batch en paralelo
+    // (0 = todos los núcleos disponibles)
+    void set_num_threads(size_t num_threads) {
+        if (num_threads == 0) {
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        num_threads_ = num_threads;
+        workers_.clear();
+        pool_ = num_threads_ > 1 ? std::make_unique<utec::parallel::ThreadPool>(num_threads_) : nullptr;
+    }
+
+    size_t num_threads() const { return num_threads_; }
+
+    // Ejecuta cada par Dense -> activación como una sola capa fusionada
+    // (activado por defecto; predict() siempre usa las capas sin fusionar)
+    void set_layer_fusion(bool enabled) {
+        fuse_layers_ = enabled;
+        reset_training_state();
+    }
+
+    // Reserva de antemano el workspace de entrenamiento para mini-batches
+    // de hasta max_rows filas (train lo hace solo en la primera época)
+    void reserve_workspace(size_t max_rows, size_t input_size, size_t output_size) {
+        plan_buffers(buffers_, steps(), max_rows, input_size, output_size);
+    }
+
+    // Memoria total de los workspaces (red principal y réplicas)
+    size_t workspace_bytes() const {
+        size_t bytes = buffers_.arena.bytes();
+        for (const auto& worker : workers_) {
+            bytes += worker.buffers.arena.bytes();
+        }
+        return bytes;
+    }
     
-    utec::algebra::Tensor<T, 2> predict(const utec::algebra::Tensor<T, 2>& input) {
-        utec::algebra::Tensor<T, 2> output = input;
+    Tensor2 predict(const Tensor2& input) {
+        PROFILE_ZONE("NeuralNetwork::predict");
+        Tensor2 output = input;
         
         for (auto& layer : layers_) {
             output = layer->forward(output);
@@ -273,36 +950,180 @@ public:
         
         return output;
     }
+
+    // Inferencia por lotes: una fila por partida/estado y un GEMM por capa.
+    // Los resultados intermedios viven en buffers internos que se reutilizan
+    // entre llamadas, así que tras la primera llamada con B filas no se
+    // asigna memoria. La referencia devuelta es válida hasta la siguiente
+    // llamada; no es seguro llamarla desde varios hilos a la vez.
+    const Tensor2& predict_batch(const Tensor2& input) {
+        PROFILE_ZONE("NeuralNetwork::predict_batch");
+        const auto& layers = steps();
+        const Tensor2* current = &input;
+        for (size_t l = 0; l < layers.size(); ++l) {
+            Tensor2& output = inference_buffers_[l % 2];
+            layers[l]->infer(*current, output);
+            current = &output;
+        }
+        return *current;
+    }
     
-    void train(const utec::algebra::Tensor<T, 2>& X, const utec::algebra::Tensor<T, 2>& y, 
-               int epochs, bool verbose = true) {
-        
-        for (int epoch = 0; epoch < epochs; ++epoch) {
-            // Forward pass
-            auto predictions = predict(X);
-            
-            // Calculate loss
-            T loss = calculate_loss(predictions, y);
-            
-            if (verbose && epoch % 10 == 0) {
-                std::cout << "Epoch " << epoch << ", Loss: " << loss << std::endl;
+    // Devuelve la pérdida media de la última época
+    T train(const Tensor2& X, const Tensor2& y, int epochs, bool verbose = true) {
+        return train_samples(TensorSamples{X, y}, epochs, verbose);
+    }
+
+    // Igual, leyendo los mini-batches directamente de los trozos del
+    // dataset (en memoria o mapeados), sin copiarlo entero a un Tensor
+    T train(const ChunkedDataset<T>& data, int epochs, bool verbose = true) {
+        return train_samples(data, epochs, verbose);
+    }
+    
+    // Guarda arquitectura y pesos en el formato binario de serialization.h.
+    // Los blobs del archivo tienen la misma alineación que los trozos de
+    // parameters_, así que todos los pesos se escriben con una sola copia.
+    void save(const std::string& path) {
+        namespace io = serialization;
+        static_assert(io::blob_alignment % sizeof(T) == 0);
+        bind_parameters();
+
+        std::vector<io::LayerRecord> records(layers_.size());
+        const size_t blobs = io::align_up(sizeof(io::ModelHeader) + layers_.size() * sizeof(io::LayerRecord));
+        auto offset_of = [&](const View& view) {
+            return blobs + static_cast<size_t>(view.data - parameters_.data()) * sizeof(T);
+        };
+        for (size_t l = 0; l < layers_.size(); ++l) {
+            io::LayerRecord& record = records[l];
+            std::string type = layers_[l]->type();
+            if (type.size() >= sizeof(record.type)) {
+                throw std::invalid_argument("Layer type too long to serialize: " + type);
             }
-            
-            // Backward pass
-            auto grad_output = calculate_loss_gradient(predictions, y);
-            
-            // Backpropagate through all layers
-            for (int i = layers_.size() - 1; i >= 0; --i) {
-                grad_output = layers_[i]->backward(grad_output);
+            std::copy(type.begin(), type.end(), record.type);
+
+            auto params = layers_[l]->parameters();
+            if (params.size() == 2) {
+                // Pesos (rows x cols) y biases (1 x cols) de una capa densa
+                record.rows = params[0].rows;
+                record.cols = params[0].cols;
+                record.weights_offset = offset_of(params[0]);
+                record.bias_offset = offset_of(params[1]);
+            } else if (!params.empty()) {
+                throw std::invalid_argument("Cannot serialize layer: " + type);
             }
-            
-            // Update weights
-            for (auto& layer : layers_) {
-                layer->update_weights(learning_rate_);
+        }
+
+        std::vector<unsigned char> bytes(blobs + parameters_.size() * sizeof(T), 0);
+        io::ModelHeader header{};
+        std::copy(std::begin(io::magic), std::end(io::magic), header.magic);
+        header.version = io::format_version;
+        header.byte_order = io::byte_order_mark;
+        header.scalar_size = sizeof(T);
+        header.layer_count = static_cast<uint32_t>(layers_.size());
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        if (!records.empty()) {
+            std::memcpy(bytes.data() + sizeof(header), records.data(), records.size() * sizeof(io::LayerRecord));
+        }
+        if (parameters_.size() > 0) {
+            std::memcpy(bytes.data() + blobs, parameters_.data(), parameters_.size() * sizeof(T));
+        }
+        io::write_file(path, bytes);
+    }
+
+    // Carga un modelo guardado con save() y reemplaza las capas actuales
+    // (la configuración de entrenamiento se conserva). El archivo queda
+    // mapeado en memoria y las capas densas leen sus pesos directamente de
+    // él; sólo se copian si se vuelve a entrenar.
+    void load(const std::string& path) {
+        namespace io = serialization;
+
+        auto file = std::make_shared<const io::MappedFile>(path);
+        const io::ModelHeader& header = io::check_header(*file, sizeof(T));
+        const auto* records = reinterpret_cast<const io::LayerRecord*>(file->data() + sizeof(io::ModelHeader));
+
+        std::vector<std::unique_ptr<Layer<T>>> layers;
+        size_t previous_cols = 0;  // salidas de la última capa densa
+        for (uint32_t l = 0; l < header.layer_count; ++l) {
+            const io::LayerRecord& record = records[l];
+            std::string type(record.type, std::find(record.type, record.type + sizeof(record.type), '\0'));
+            if (type == "dense") {
+                // Las formas vienen del archivo: rows * cols no puede
+                // desbordarse antes de la comprobación de rango de blob
+                if (record.rows == 0 || record.cols == 0 || record.cols > SIZE_MAX ||
+                    record.rows > SIZE_MAX / record.cols) {
+                    throw std::runtime_error("Model file has an invalid dense layer shape");
+                }
+                size_t rows = record.rows;
+                size_t cols = record.cols;
+                if (previous_cols != 0 && rows != previous_cols) {
+                    throw std::runtime_error("Model file has mismatched dense layer shapes");
+                }
+                previous_cols = cols;
+                const T* weights = io::blob<T>(*file, record.weights_offset, rows * cols);
+                const T* biases = io::blob<T>(*file, record.bias_offset, cols);
+                layers.push_back(std::make_unique<DenseLayer<T>>(rows, cols, file, weights, biases));
+            } else if (type.rfind("activation_", 0) == 0) {
+                layers.push_back(make_activation_layer<T>(type.substr(11)));
+            } else {
+                throw std::runtime_error("Unknown layer type in model file: " + type);
             }
         }
+
+        layers_ = std::move(layers);
+        reset_training_state();
     }
-    
+
+    // Número de parámetros entrenables (sin el relleno entre tensores)
+    size_t parameter_count() const {
+        size_t count = 0;
+        for (const auto& layer : layers_) {
+            for (const auto& shape : layer->parameter_shapes()) count += shape[0] * shape[1];
+        }
+        return count;
+    }
+
+    // Todos los parámetros en un vector plano: por capa, los pesos
+    // (row-major) y luego los biases, sin el relleno entre tensores. Es el
+    // orden que espera StaticNetwork::assign(const T*).
+    std::vector<T> get_parameters() {
+        bind_parameters();
+        std::vector<T> values;
+        values.reserve(parameter_count());
+        for (auto& layer : layers_) {
+            for (const auto& view : layer->parameters()) {
+                values.insert(values.end(), view.data, view.data + view.size());
+            }
+        }
+        return values;
+    }
+
+    // Reemplaza los parámetros con un vector en el orden de get_parameters
+    void set_parameters(const std::vector<T>& values) {
+        if (values.size() != parameter_count()) {
+            throw std::invalid_argument("Parameter vector size does not match the network");
+        }
+        bind_parameters();
+        const T* source = values.data();
+        for (auto& layer : layers_) {
+            for (const auto& view : layer->parameters()) {
+                std::copy_n(source, view.size(), view.data);
+                source += view.size();
+            }
+        }
+    }
+
+    // Norma L2 del gradiente del último mini-batch, de todas las capas
+    T gradient_norm() const {
+        T sum = T{0};
+        const T* g = gradients_.data();
+        for (size_t i = 0; i < gradients_.size(); ++i) {
+            sum += g[i] * g[i];
+        }
+        return std::sqrt(sum);
+    }
+
+    // Capas en el orden en que se agregaron (sin fusionar)
+    const std::vector<std::unique_ptr<Layer<T>>>& layers() const { return layers_; }
+
     void print_architecture() {
         std::cout << "Neural Network Architecture:" << std::endl;
         for (size_t i = 0; i < layers_.size(); ++i) {
@@ -0,0 +1,368 @@
+#ifndef NN_OPTIMIZER_H
+#define NN_OPTIMIZER_H
+
+// Optimizadores para NeuralNetwork::set_optimizer: "sgd", "momentum",
+// "rmsprop" y "adam".
+//
+// La red guarda todos sus parámetros y gradientes en dos buffers contiguos
+// y el estado de cada optimizador (velocidad, promedios de g y g^2) tiene
+// la misma disposición, así que un paso es un solo recorrido lineal:
+// parámetro, gradiente y estado avanzan juntos. Para float el recorrido usa
+// AVX2 o AVX-512 según gemm::active_isa(), como los kernels de activación.
+
+#include "gemm.h"
+#include "profiler.h"
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+
+namespace utec {
+namespace neural_network {
+
+namespace optimizer_detail {
+
+// Hiperparámetros de un paso (ya corregidos por el número de paso en Adam)
+struct Hyper {
+    float lr;
+    float decay1;   // momentum / rho / beta1
+    float decay2;   // beta2
+    float eps;
+};
+
+// Reglas de actualización por elemento: p es el parámetro, g su gradiente
+// y s0/s1 las celdas de estado (slots indica cuántas usa).
+
+// p -= lr * g
+struct SgdStep {
+    static constexpr int slots = 0;
+    template<typename T>
+    static void scalar(T& p, T g, T&, T&, const Hyper& h) { p -= T(h.lr) * g; }
+#ifdef UTEC_GEMM_X86
+    __attribute__((target("avx2,fma")))
+    static void avx2(__m256& p, __m256 g, __m256&, __m256&, const Hyper& h) {
+        p = _mm256_fnmadd_ps(_mm256_set1_ps(h.lr), g, p);
+    }
+    __attribute__((target("avx512f")))
+    static void avx512(__m512& p, __m512 g, __m512&, __m512&, const Hyper& h) {
+        p = _mm512_fnmadd_ps(_mm512_set1_ps(h.lr), g, p);
+    }
+#endif
+};
+
+// v = mu * v + g; p -= lr * v
+struct MomentumStep {
+    static constexpr int slots = 1;
+    template<typename T>
+    static void scalar(T& p, T g, T& v, T&, const Hyper& h) {
+        v = T(h.decay1) * v + g;
+        p -= T(h.lr) * v;
+    }
+#ifdef UTEC_GEMM_X86
+    __attribute__((target("avx2,fma")))
+    static void avx2(__m256& p, __m256 g, __m256& v, __m256&, const Hyper& h) {
+        v = _mm256_fmadd_ps(_mm256_set1_ps(h.decay1), v, g);
+        p = _mm256_fnmadd_ps(_mm256_set1_ps(h.lr), v, p);
+    }
+    __attribute__((target("avx512f")))
+    static void avx512(__m512& p, __m512 g, __m512& v, __m512&, const Hyper& h) {
+        v = _mm512_fmadd_ps(_mm512_set1_ps(h.decay1), v, g);
+        p = _mm512_fnmadd_ps(_mm512_set1_ps(h.lr), v, p);
+    }
+#endif
+};
+
+// s = rho * s + (1 - rho) * g^2; p -= lr * g / (sqrt(s) + eps)
+struct RmspropStep {
+    static constexpr int slots = 1;
+    template<typename T>
+    static void scalar(T& p, T g, T& s, T&, const Hyper& h) {
+        s = T(h.decay1) * s + T(1 - h.decay1) * g * g;
+        p -= T(h.lr) * g / (std::sqrt(s) + T(h.eps));
+    }
+#ifdef UTEC_GEMM_X86
+    __attribute__((target("avx2,fma")))
+    static void avx2(__m256& p, __m256 g, __m256& s, __m256&, const Hyper& h) {
+        s = _mm256_fmadd_ps(_mm256_set1_ps(h.decay1), s, _mm256_mul_ps(_mm256_set1_ps(1 - h.decay1), _mm256_mul_ps(g, g)));
+        __m256 denom = _mm256_add_ps(_mm256_sqrt_ps(s), _mm256_set1_ps(h.eps));
+        p = _mm256_fnmadd_ps(_mm256_set1_ps(h.lr), _mm256_div_ps(g, denom), p);
+    }
+    __attribute__((target("avx512f")))
+    static void avx512(__m512& p, __m512 g, __m512& s, __m512&, const Hyper& h) {
+        s = _mm512_fmadd_ps(_mm512_set1_ps(h.decay1), s, _mm512_mul_ps(_mm512_set1_ps(1 - h.decay1), _mm512_mul_ps(g, g)));
+        __m512 denom = _mm512_add_ps(_mm512_maskz_sqrt_ps(0xFFFF, s), _mm512_set1_ps(h.eps));
+        p = _mm512_fnmadd_ps(_mm512_set1_ps(h.lr), _mm512_div_ps(g, denom), p);
+    }
+#endif
+};
+
+// m = b1 * m + (1 - b1) * g; v = b2 * v + (1 - b2) * g^2;
+// p -= lr_t * m / (sqrt(v) + eps_t), con la corrección de sesgo ya
+// incluida en lr_t y eps_t
+struct AdamStep {
+    static constexpr int slots = 2;
+    template<typename T>
+    static void scalar(T& p, T g, T& m, T& v, const Hyper& h) {
+        m = T(h.decay1) * m + T(1 - h.decay1) * g;
+        v = T(h.decay2) * v + T(1 - h.decay2) * g * g;
+        p -= T(h.lr) * m / (std::sqrt(v) + T(h.eps));
+    }
+#ifdef UTEC_GEMM_X86
+    __attribute__((target("avx2,fma")))
+    static void avx2(__m256& p, __m256 g, __m256& m, __m256& v, const Hyper& h) {
+        m = _mm256_fmadd_ps(_mm256_set1_ps(h.decay1), m, _mm256_mul_ps(_mm256_set1_ps(1 - h.decay1), g));
+        v = _mm256_fmadd_ps(_mm256_set1_ps(h.decay2), v, _mm256_mul_ps(_mm256_set1_ps(1 - h.decay2), _mm256_mul_ps(g, g)));
+        __m256 denom = _mm256_add_ps(_mm256_sqrt_ps(v), _mm256_set1_ps(h.eps));
+        p = _mm256_fnmadd_ps(_mm256_set1_ps(h.lr), _mm256_div_ps(m, denom), p);
+    }
+    __attribute__((target("avx512f")))
+    static void avx512(__m512& p, __m512 g, __m512& m, __m512& v, const Hyper& h) {
+        m = _mm512_fmadd_ps(_mm512_set1_ps(h.decay1), m, _mm512_mul_ps(_mm512_set1_ps(1 - h.decay1), g));
+        v = _mm512_fmadd_ps(_mm512_set1_ps(h.decay2), v, _mm512_mul_ps(_mm512_set1_ps(1 - h.decay2), _mm512_mul_ps(g, g)));
+        __m512 denom = _mm512_add_ps(_mm512_maskz_sqrt_ps(0xFFFF, v), _mm512_set1_ps(h.eps));
+        p = _mm512_fnmadd_ps(_mm512_set1_ps(h.lr), _mm512_div_ps(m, denom), p);
+    }
+#endif
+};
+
+// Recorridos de n elementos. Los slots que la regla no usa no se leen ni
+// escriben (s0/s1 pueden ser nulos). El resto se procesa con máscaras.
+// (sqrt AVX-512 con máscara completa por lo mismo que en activation.h)
+#ifdef UTEC_GEMM_X86
+template<bool Full>
+__attribute__((target("avx2,fma")))
+inline __m256 load_avx2(const float* a, __m256i mask) {
+    if constexpr (Full) return _mm256_loadu_ps(a);
+    else return _mm256_maskload_ps(a, mask);
+}
+
+template<bool Full>
+__attribute__((target("avx2,fma")))
+inline void store_avx2(float* a, __m256i mask, __m256 v) {
+    if constexpr (Full) _mm256_storeu_ps(a, v);
+    else _mm256_maskstore_ps(a, mask, v);
+}
+
+template<typename Step, bool Full>
+__attribute__((target("avx2,fma")))
+inline void block_avx2(float* p, const float* g, float* s0, float* s1, __m256i mask, const Hyper& h) {
+    __m256 vp = load_avx2<Full>(p, mask);
+    __m256 vs0 = _mm256_setzero_ps();
+    __m256 vs1 = _mm256_setzero_ps();
+    if constexpr (Step::slots > 0) vs0 = load_avx2<Full>(s0, mask);
+    if constexpr (Step::slots > 1) vs1 = load_avx2<Full>(s1, mask);
+    Step::avx2(vp, load_avx2<Full>(g, mask), vs0, vs1, h);
+    store_avx2<Full>(p, mask, vp);
+    if constexpr (Step::slots > 0) store_avx2<Full>(s0, mask, vs0);
+    if constexpr (Step::slots > 1) store_avx2<Full>(s1, mask, vs1);
+}
+
+template<typename Step>
+__attribute__((target("avx2,fma")))
+void update_avx2(float* p, const float* g, float* s0, float* s1, size_t n, const Hyper& h) {
+    const __m256i all = _mm256_set1_epi32(-1);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        block_avx2<Step, true>(p + i, g + i, s0 ? s0 + i : nullptr, s1 ? s1 + i : nullptr, all, h);
+    }
+    if (i < n) {
+        const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(n - i)), lanes);
+        block_avx2<Step, false>(p + i, g + i, s0 ? s0 + i : nullptr, s1 ? s1 + i : nullptr, mask, h);
+    }
+}
+
+template<typename Step>
+__attribute__((target("avx512f")))
+void update_avx512(float* p, const float* g, float* s0, float* s1, size_t n, const Hyper& h) {
+    for (size_t i = 0; i < n; i += 16) {
+        const __mmask16 mask = i + 16 <= n ? __mmask16(0xFFFF) : static_cast<__mmask16>((1u << (n - i)) - 1);
+        __m512 vp = _mm512_maskz_loadu_ps(mask, p + i);
+        __m512 vs0 = _mm512_setzero_ps();
+        __m512 vs1 = _mm512_setzero_ps();
+        if constexpr (Step::slots > 0) vs0 = _mm512_maskz_loadu_ps(mask, s0 + i);
+        if constexpr (Step::slots > 1) vs1 = _mm512_maskz_loadu_ps(mask, s1 + i);
+        Step::avx512(vp, _mm512_maskz_loadu_ps(mask, g + i), vs0, vs1, h);
+        _mm512_mask_storeu_ps(p + i, mask, vp);
+        if constexpr (Step::slots > 0) _mm512_mask_storeu_ps(s0 + i, mask, vs0);
+        if constexpr (Step::slots > 1) _mm512_mask_storeu_ps(s1 + i, mask, vs1);
+    }
+}
+#endif
+
+template<typename Step, typename T>
+void update(T* p, const T* g, T* s0, T* s1, size_t n, const Hyper& h) {
+    if constexpr (std::is_same_v<T, float>) {
+#ifdef UTEC_GEMM_X86
+        switch (utec::algebra::gemm::active_isa()) {
+            case utec::algebra::gemm::Isa::avx512: update_avx512<Step>(p, g, s0, s1, n, h); return;
+            case utec::algebra::gemm::Isa::avx2:   update_avx2<Step>(p, g, s0, s1, n, h); return;
+            default: break;
+        }
+#endif
+    }
+    T unused0{}, unused1{};
+    for (size_t i = 0; i < n; ++i) {
+        T& a = Step::slots > 0 ? s0[i] : unused0;
+        T& b = Step::slots > 1 ? s1[i] : unused1;
+        Step::scalar(p[i], g[i], a, b, h);
+    }
+}
+
+} // namespace optimizer_detail
+
+template<typename T>
+class Optimizer {
+public:
+    explicit Optimizer(T learning_rate) : learning_rate_(learning_rate) {}
+    virtual ~Optimizer() = default;
+
+    virtual std::string name() const = 0;
+
+    // Un paso sobre n parámetros contiguos y sus gradientes. El estado se
+    // crea (en cero) en el primer paso y se reinicia si cambia n.
+    void step(T* params, const T* grads, size_t n) {
+        PROFILE_ZONE("Optimizer::step");
+        if (n != total_) {
+            total_ = n;
+            state_.assign(slots() * n, T{0});
+            steps_ = 0;
+        }
+        ++steps_;
+
+        T* s0 = slots() > 0 ? state_.data() : nullptr;
+        T* s1 = slots() > 1 ? state_.data() + n : nullptr;
+        update(params, grads, s0, s1, n, hyperparameters());
+    }
+
+    // Olvida el estado (p.ej. al cambiar la arquitectura o cargar un modelo)
+    void reset() {
+        state_.clear();
+        total_ = 0;
+        steps_ = 0;
+    }
+
+    T learning_rate() const { return learning_rate_; }
+    void set_learning_rate(T learning_rate) { learning_rate_ = learning_rate; }
+    size_t steps() const { return steps_; }
+
+protected:
+    T learning_rate_;
+    size_t steps_ = 0;
+
+    // Celdas de estado por parámetro (0, 1 o 2)
+    virtual size_t slots() const = 0;
+    virtual optimizer_detail::Hyper hyperparameters() const = 0;
+    virtual void update(T* p, const T* g, T* s0, T* s1, size_t n, const optimizer_detail::Hyper& h) = 0;
+
+private:
+    std::vector<T> state_;   // slots() bloques de total_ elementos
+    size_t total_ = 0;
+};
+
+template<typename T>
+class SGD : public Optimizer<T> {
+public:
+    using Optimizer<T>::Optimizer;
+    std::string name() const override { return "sgd"; }
+
+protected:
+    size_t slots() const override { return 0; }
+    optimizer_detail::Hyper hyperparameters() const override {
+        return {float(this->learning_rate_), 0.0f, 0.0f, 0.0f};
+    }
+    void update(T* p, const T* g, T* s0, T* s1, size_t n, const optimizer_detail::Hyper& h) override {
+        optimizer_detail::update<optimizer_detail::SgdStep>(p, g, s0, s1, n, h);
+    }
+};
+
+template<typename T>
+class Momentum : public Optimizer<T> {
+private:
+    T momentum_;
+
+public:
+    explicit Momentum(T learning_rate, T momentum = T(0.9))
+        : Optimizer<T>(learning_rate), momentum_(momentum) {}
+    std::string name() const override { return "momentum"; }
+
+protected:
+    size_t slots() const override { return 1; }
+    optimizer_detail::Hyper hyperparameters() const override {
+        return {float(this->learning_rate_), float(momentum_), 0.0f, 0.0f};
+    }
+    void update(T* p, const T* g, T* s0, T* s1, size_t n, const optimizer_detail::Hyper& h) override {
+        optimizer_detail::update<optimizer_detail::MomentumStep>(p, g, s0, s1, n, h);
+    }
+};
+
+template<typename T>
+class RMSProp : public Optimizer<T> {
+private:
+    T rho_;
+    T eps_;
+
+public:
+    explicit RMSProp(T learning_rate, T rho = T(0.9), T eps = T(1e-8))
+        : Optimizer<T>(learning_rate), rho_(rho), eps_(eps) {}
+    std::string name() const override { return "rmsprop"; }
+
+protected:
+    size_t slots() const override { return 1; }
+    optimizer_detail::Hyper hyperparameters() const override {
+        return {float(this->learning_rate_), float(rho_), 0.0f, float(eps_)};
+    }
+    void update(T* p, const T* g, T* s0, T* s1, size_t n, const optimizer_detail::Hyper& h) override {
+        optimizer_detail::update<optimizer_detail::RmspropStep>(p, g, s0, s1, n, h);
+    }
+};
+
+template<typename T>
+class Adam : public Optimizer<T> {
+private:
+    T beta1_;
+    T beta2_;
+    T eps_;
+
+public:
+    explicit Adam(T learning_rate, T beta1 = T(0.9), T beta2 = T(0.999), T eps = T(1e-8))
+        : Optimizer<T>(learning_rate), beta1_(beta1), beta2_(beta2), eps_(eps) {}
+    std::string name() const override { return "adam"; }
+
+protected:
+    size_t slots() const override { return 2; }
+
+    // lr * m_hat / (sqrt(v_hat) + eps) = lr_t * m / (sqrt(v) + eps_t)
+    optimizer_detail::Hyper hyperparameters() const override {
+        double t = double(this->steps_);
+        double c1 = 1.0 - std::pow(double(beta1_), t);
+        double c2 = std::sqrt(1.0 - std::pow(double(beta2_), t));
+        return {float(this->learning_rate_ * c2 / c1), float(beta1_), float(beta2_), float(eps_ * c2)};
+    }
+    void update(T* p, const T* g, T* s0, T* s1, size_t n, const optimizer_detail::Hyper& h) override {
+        optimizer_detail::update<optimizer_detail::AdamStep>(p, g, s0, s1, n, h);
+    }
+};
+
+// Crea el optimizador por nombre ("sgd", "momentum", "rmsprop", "adam")
+template<typename T>
+std::unique_ptr<Optimizer<T>> make_optimizer(const std::string& name, T learning_rate) {
+    if (name == "sgd") {
+        return std::make_unique<SGD<T>>(learning_rate);
+    } else if (name == "momentum") {
+        return std::make_unique<Momentum<T>>(learning_rate);
+    } else if (name == "rmsprop") {
+        return std::make_unique<RMSProp<T>>(learning_rate);
+    } else if (name == "adam") {
+        return std::make_unique<Adam<T>>(learning_rate);
+    }
+    throw std::invalid_argument("Unknown optimizer: " + name);
+}
+
+} // namespace neural_network
+} // namespace utec
+
+#endif // NN_OPTIMIZER_H
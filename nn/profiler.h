@@ -0,0 +1,346 @@
+#ifndef NN_PROFILER_H
+#define NN_PROFILER_H
+
+// Perfilado ligero de los caminos críticos.
+//
+//     PROFILE_ZONE("DenseLayer::forward");    // mide hasta el final del bloque
+//     PROFILE_COUNT("trainer.samples", n);    // valor de un contador
+//
+// Las macros sólo generan código si se compila con PONGSASOS_PROFILE=1; si
+// no, se expanden a nada y no cuestan nada. Compiladas, una zona cuesta dos
+// lecturas del reloj y un evento, y se pueden apagar en ejecución con
+// Profiler::set_enabled(false).
+//
+// Cada hilo escribe sus eventos en su propio anillo, sin locks: cuando se
+// llena se sobrescriben los más viejos. Los anillos sólo se leen con loads
+// atómicos desde el hilo que arma los reportes (el del juego): frame()
+// junta lo ocurrido desde el fotograma anterior (ms por zona, histograma
+// de tiempos de fotograma) y write_chrome_trace() exporta lo que queda en
+// los anillos en el formato de chrome://tracing / Perfetto.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace utec {
+namespace profiling {
+
+#if defined(PONGSASOS_PROFILE) && PONGSASOS_PROFILE
+constexpr bool compiled_in = true;
+#else
+constexpr bool compiled_in = false;
+#endif
+
+// Evento leído de un anillo
+struct Event {
+    const char* name;
+    uint64_t begin_ns;
+    uint64_t end_ns;     // = begin_ns en los contadores
+    double value;        // sólo contadores
+    bool counter;
+};
+
+// Anillo de eventos de un hilo: un solo escritor (el hilo dueño) y lectores
+// que sólo cargan atómicos; un evento que se sobrescribe mientras se lee
+// se descarta
+class ThreadRing {
+public:
+    static constexpr size_t capacity = size_t{1} << 15;
+
+    ThreadRing(uint32_t id, std::string name) : id_(id), name_(std::move(name)), slots_(new Slot[capacity]) {}
+
+    void push(const char* name, uint64_t begin, uint64_t payload, bool counter) {
+        uint64_t index = written_.load(std::memory_order_relaxed);
+        // Como en un seqlock: quien lea un campo de este evento verá también
+        // written_ >= index, y así sabe que la ranura index - capacity ya no vale
+        std::atomic_thread_fence(std::memory_order_release);
+        Slot& slot = slots_[index & (capacity - 1)];
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.begin.store(begin, std::memory_order_relaxed);
+        slot.payload.store(payload, std::memory_order_relaxed);
+        slot.counter.store(counter, std::memory_order_relaxed);
+        written_.store(index + 1, std::memory_order_release);
+    }
+
+    // Eventos que conserva el anillo: la ranura más vieja puede estar
+    // reescribiéndose en cualquier momento
+    static constexpr size_t retained = capacity - 1;
+
+    // Llama a f(Event) con los eventos desde el índice `from` (o los más
+    // viejos que sigan en el anillo) y devuelve el índice siguiente
+    template<typename F>
+    uint64_t read(uint64_t from, F&& f) const {
+        uint64_t end = written_.load(std::memory_order_acquire);
+        uint64_t begin = std::max(from, end > retained ? end - retained : 0);
+        for (uint64_t i = begin; i < end; ++i) {
+            const Slot& slot = slots_[i & (capacity - 1)];
+            Event event;
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.begin_ns = slot.begin.load(std::memory_order_relaxed);
+            uint64_t payload = slot.payload.load(std::memory_order_relaxed);
+            event.counter = slot.counter.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // Si el escritor ya empezó a reutilizar la ranura, el evento puede estar mezclado
+            if (written_.load(std::memory_order_relaxed) >= i + capacity) continue;
+            if (event.counter) {
+                std::memcpy(&event.value, &payload, sizeof(double));
+                event.end_ns = event.begin_ns;
+            } else {
+                event.value = 0.0;
+                event.end_ns = payload;
+            }
+            f(event);
+        }
+        return end;
+    }
+
+    uint32_t id() const { return id_; }
+    const std::string& name() const { return name_; }
+    void set_name(std::string name) { name_ = std::move(name); }
+
+private:
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> begin{0};
+        std::atomic<uint64_t> payload{0};
+        std::atomic<bool> counter{false};
+    };
+
+    uint32_t id_;
+    std::string name_;   // protegido por el mutex del Profiler
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<uint64_t> written_{0};
+};
+
+// Totales de una zona en el último fotograma
+struct ZoneTotal {
+    const char* name;
+    double ms;
+    uint32_t calls;
+};
+
+class Profiler {
+public:
+    static constexpr size_t frame_history = 240;     // fotogramas recordados
+    static constexpr size_t histogram_bins = 34;     // 1 ms por barra, la última acumula el resto
+
+    static Profiler& instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    static bool enabled() { return instance().enabled_.load(std::memory_order_relaxed); }
+    void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    // Nanosegundos desde que se creó el Profiler
+    uint64_t now_ns() const {
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - epoch_).count());
+    }
+
+    // Anillo del hilo actual. La primera vez se le asigna uno (el de un
+    // hilo que ya terminó, si hay) y queda libre cuando el hilo termina;
+    // así los hilos de vida corta no acumulan anillos.
+    ThreadRing& local() {
+        thread_local ThreadRing* ring = nullptr;   // trivial: acceso barato
+        if (!ring) ring = &attach();
+        return *ring;
+    }
+
+    void zone(const char* name, uint64_t begin, uint64_t end) { local().push(name, begin, end, false); }
+
+    void count(const char* name, double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        local().push(name, now_ns(), bits, true);
+    }
+
+    // Nombre del hilo actual en la traza
+    void set_thread_name(const std::string& name) {
+        ThreadRing& ring = local();
+        std::lock_guard<std::mutex> lock(mutex_);
+        ring.set_name(name);
+    }
+
+    // Cierra un fotograma (hilo del juego): suma por zona lo que terminó
+    // desde la llamada anterior, en todos los hilos. Tras los primeros
+    // fotogramas no asigna memoria.
+    void frame() {
+        uint64_t now = now_ns();
+        if (last_frame_ns_ != 0) {
+            float ms = float(now - last_frame_ns_) * 1e-6f;
+            frame_ms_[frames_ % frame_history] = ms;
+            ++frames_;
+        }
+        last_frame_ns_ = now;
+
+        for (auto& total : zones_) {
+            total.ms = 0.0;
+            total.calls = 0;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        cursors_.resize(rings_.size(), 0);
+        for (size_t r = 0; r < rings_.size(); ++r) {
+            cursors_[r] = rings_[r]->read(cursors_[r], [this](const Event& event) {
+                if (event.counter) return;
+                auto it = std::find_if(zones_.begin(), zones_.end(),
+                                       [&event](const ZoneTotal& z) { return z.name == event.name; });
+                if (it == zones_.end()) {
+                    zones_.push_back({event.name, 0.0, 0});
+                    it = zones_.end() - 1;
+                }
+                it->ms += double(event.end_ns - event.begin_ns) * 1e-6;
+                it->calls++;
+            });
+        }
+    }
+
+    // Zonas vistas hasta ahora con sus totales del último fotograma
+    const std::vector<ZoneTotal>& zones() const { return zones_; }
+
+    // Duración de los últimos min(frames(), frame_history) fotogramas (ms)
+    size_t frames() const { return frames_; }
+    float frame_ms(size_t ago) const { return frame_ms_[(frames_ - 1 - ago) % frame_history]; }
+
+    // Cuántos de los fotogramas recordados cayeron en cada milisegundo
+    std::array<uint32_t, histogram_bins> histogram() const {
+        std::array<uint32_t, histogram_bins> bins{};
+        size_t count = std::min(frames_, frame_history);
+        for (size_t i = 0; i < count; ++i) {
+            size_t bin = std::min(size_t(frame_ms_[i]), histogram_bins - 1);
+            bins[bin]++;
+        }
+        return bins;
+    }
+
+    // Escribe los eventos que siguen en los anillos como traza JSON de
+    // Chrome (Trace Event Format); devuelve cuántos eventos se escribieron
+    size_t write_chrome_trace(const std::string& path) {
+        std::ofstream out(path);
+        if (!out) {
+            throw std::runtime_error("Cannot open trace file: " + path);
+        }
+        out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+        size_t written = 0;
+        auto separator = [&]() -> std::ofstream& {
+            out << (written++ ? ",\n" : "\n");
+            return out;
+        };
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& ring : rings_) {
+            separator() << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << ring->id()
+                        << ", \"args\": {\"name\": \"" << ring->name() << "\"}}";
+            ring->read(0, [&](const Event& event) {
+                double ts = double(event.begin_ns) * 1e-3;
+                if (event.counter) {
+                    separator() << "{\"name\": \"" << event.name << "\", \"ph\": \"C\", \"pid\": 1, \"tid\": "
+                                << ring->id() << ", \"ts\": " << ts << ", \"args\": {\"value\": " << event.value << "}}";
+                } else {
+                    separator() << "{\"name\": \"" << event.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+                                << ring->id() << ", \"ts\": " << ts
+                                << ", \"dur\": " << double(event.end_ns - event.begin_ns) * 1e-3 << "}";
+                }
+            });
+        }
+        out << "\n]}\n";
+        if (!out) {
+            throw std::runtime_error("Cannot write trace file: " + path);
+        }
+        return written;
+    }
+
+private:
+    // Libera el anillo del hilo cuando éste termina
+    struct Detach {
+        Profiler* profiler;
+        size_t index;
+        ~Detach() {
+            std::lock_guard<std::mutex> lock(profiler->mutex_);
+            profiler->in_use_[index] = false;
+        }
+    };
+
+    ThreadRing& attach() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        size_t index = size_t(std::find(in_use_.begin(), in_use_.end(), false) - in_use_.begin());
+        if (index == rings_.size()) {
+            rings_.push_back(std::make_unique<ThreadRing>(uint32_t(index), ""));
+            in_use_.push_back(false);
+        }
+        in_use_[index] = true;
+        ThreadRing& ring = *rings_[index];
+        ring.set_name("hilo " + std::to_string(index));
+        lock.unlock();
+        thread_local Detach detach{this, index};
+        return ring;
+    }
+
+    Profiler() : epoch_(std::chrono::steady_clock::now()) {
+        frame_ms_.fill(0.0f);
+    }
+
+    std::chrono::steady_clock::time_point epoch_;
+    std::atomic<bool> enabled_{true};
+
+    std::mutex mutex_;   // registro de anillos y nombres
+    std::vector<std::unique_ptr<ThreadRing>> rings_;
+    std::vector<bool> in_use_;   // anillos con un hilo vivo
+
+    // Estado del lector (hilo del juego)
+    std::vector<uint64_t> cursors_;
+    std::vector<ZoneTotal> zones_;
+    std::array<float, frame_history> frame_ms_;
+    size_t frames_ = 0;
+    uint64_t last_frame_ns_ = 0;
+};
+
+// Zona RAII: mide desde su construcción hasta el final del bloque
+class Zone {
+public:
+    explicit Zone(const char* name)
+        : name_(Profiler::enabled() ? name : nullptr), begin_(name_ ? Profiler::instance().now_ns() : 0) {}
+
+    ~Zone() {
+        if (name_) {
+            Profiler& profiler = Profiler::instance();
+            profiler.zone(name_, begin_, profiler.now_ns());
+        }
+    }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    const char* name_;
+    uint64_t begin_;
+};
+
+inline void count(const char* name, double value) {
+    if (Profiler::enabled()) Profiler::instance().count(name, value);
+}
+
+} // namespace profiling
+} // namespace utec
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#if defined(PONGSASOS_PROFILE) && PONGSASOS_PROFILE
+#define PROFILE_ZONE(name) ::utec::profiling::Zone PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#define PROFILE_COUNT(name, value) ::utec::profiling::count(name, double(value))
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_COUNT(name, value) ((void)0)
+#endif
+
+#endif // NN_PROFILER_H
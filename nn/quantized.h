@@ -0,0 +1,498 @@
+#ifndef NN_QUANTIZED_H
+#define NN_QUANTIZED_H
+
+// Inferencia por lotes con pesos de menor precisión para redes densas con
+// tanh después de cada capa (la política del AIPaddle), a partir de una
+// NeuralNetwork<float> ya entrenada. Sólo sirve para predecir.
+//
+//  - bf16 / fp16: los pesos se guardan en 16 bits (la mitad de memoria) y
+//    se convierten a float al empezar cada predict_batch; el cálculo y la
+//    acumulación siguen en fp32 con el GEMM de siempre.
+//  - int8 (cuantización post-entrenamiento): con estados de calibración
+//    (p.ej. un TrainingSet grabado) se mide el máximo |x| de cada canal de
+//    entrada de cada capa. La escala de cada canal de entrada se absorbe en
+//    los pesos, que luego se cuantizan con una escala por canal de salida.
+//    Cada fila se cuantiza a int8, se multiplica int8 x int8 -> int32
+//    (AVX-512 VNNI, AVX2 o escalar) y se descuantiza a float antes de la
+//    tanh; la salida de la red es float.
+//
+// Los pesos int8 se empaquetan en grupos de 4 entradas por salida
+// ([k/4][salida][4]), el formato de vpdpbusd: una instrucción hace 64
+// productos de 16 salidas. Como vpdpbusd multiplica u8 x s8, la entrada se
+// desplaza en +128 y al final se resta 128 * (suma de la columna).
+
+#include "network.h"
+#include "activation.h"
+#include "dataset.h"
+#include "gemm.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace utec {
+namespace neural_network {
+
+enum class Precision { fp32, bf16, fp16, int8 };
+
+inline const char* precision_name(Precision precision) {
+    switch (precision) {
+        case Precision::bf16: return "bf16";
+        case Precision::fp16: return "fp16";
+        case Precision::int8: return "int8";
+        default:              return "fp32";
+    }
+}
+
+// Conversiones a 16 bits con redondeo al par más cercano
+inline uint16_t to_bf16(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if ((bits & 0x7fffffffu) > 0x7f800000u) return uint16_t((bits >> 16) | 0x40u);  // NaN
+    bits += 0x7fffu + ((bits >> 16) & 1u);
+    return uint16_t(bits >> 16);
+}
+
+inline float from_bf16(uint16_t half) {
+    uint32_t bits = uint32_t(half) << 16;
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline uint16_t to_fp16(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t abs = bits & 0x7fffffffu;
+    if (abs >= 0x7f800000u) return uint16_t(sign | (abs > 0x7f800000u ? 0x7e00u : 0x7c00u));
+    if (abs >= 0x477ff000u) return uint16_t(sign | 0x7c00u);   // >= 65520: infinito
+    if (abs < 0x38800000u) {
+        // Subnormal en fp16 (|x| < 2^-14): múltiplos de 2^-24
+        if (abs < 0x33000000u) return uint16_t(sign);
+        uint32_t exponent = abs >> 23;
+        uint32_t mantissa = (abs & 0x7fffffu) | 0x800000u;
+        uint32_t shift = 126 - exponent;
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1);
+        uint32_t tie = 1u << (shift - 1);
+        if (rest > tie || (rest == tie && (half & 1u))) ++half;
+        return uint16_t(sign | half);
+    }
+    uint32_t half = (abs - 0x38000000u) >> 13;
+    uint32_t rest = abs & 0x1fffu;
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) ++half;
+    return uint16_t(sign | half);
+}
+
+inline float from_fp16(uint16_t half) {
+    uint32_t sign = uint32_t(half & 0x8000u) << 16;
+    uint32_t exponent = (half >> 10) & 0x1fu;
+    uint32_t mantissa = half & 0x3ffu;
+    if (exponent == 0) {
+        float value = std::ldexp(float(mantissa), -24);
+        return sign ? -value : value;
+    }
+    uint32_t bits = exponent == 31 ? sign | 0x7f800000u | (mantissa << 13)
+                                   : sign | ((exponent + 112) << 23) | (mantissa << 13);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+namespace quantized_detail {
+
+// Salidas por bloque del kernel int8 (un registro de 512 bits de int32) y
+// entradas que se cuantizan de una vez
+constexpr size_t NR = 16;
+constexpr size_t KB = 16;
+
+// Capa int8 empaquetada (vista sobre los vectores de QuantizedNetwork)
+struct PackedLayer {
+    size_t in, out;
+    size_t groups;                // ceil(in / 4)
+    size_t out_padded;            // múltiplo de NR
+    const int8_t* weights;        // [groups][out_padded][4]
+    const int32_t* offsets;       // 128 * suma de cada columna (VNNI)
+    const float* inverse_scale;   // por entrada: x_q = round(x / escala)
+    const float* output_scale;    // out_padded: y = acc * escala + bias
+    const float* biases;          // out_padded
+};
+
+// Un kernel hace la capa completa para rows filas: cuantiza cada fila de x
+// (en scratch, ceil(in / KB) * KB bytes), la multiplica int8 x int8 ->
+// int32 y escribe y = acc * output_scale + bias (antes de la tanh). Todos
+// redondean al par más cercano y saturan a [-127, 127].
+using LayerKernel = void (*)(const PackedLayer& layer, const float* x, size_t rows, float* y, int8_t* scratch);
+
+inline int8_t quantize(float x, float inverse_scale) {
+    float q = std::min(std::max(x * inverse_scale, -127.0f), 127.0f);
+    // Redondeo al par sin libm: sumar y restar 1.5 * 2^23
+    const float magic = 12582912.0f;
+    return int8_t(int32_t((q + magic) - magic));
+}
+
+inline void layer_scalar(const PackedLayer& layer, const float* x, size_t rows, float* y, int8_t* q) {
+    for (size_t r = 0; r < rows; ++r, x += layer.in, y += layer.out) {
+        for (size_t i = 0; i < layer.in; ++i) q[i] = quantize(x[i], layer.inverse_scale[i]);
+        std::fill(q + layer.in, q + layer.groups * 4, int8_t{0});
+        for (size_t j = 0; j < layer.out; ++j) {
+            int32_t acc = 0;
+            for (size_t g = 0; g < layer.groups; ++g) {
+                const int8_t* w = layer.weights + (g * layer.out_padded + j) * 4;
+                const int8_t* qg = q + 4 * g;
+                acc += int32_t(qg[0]) * w[0] + int32_t(qg[1]) * w[1] + int32_t(qg[2]) * w[2] + int32_t(qg[3]) * w[3];
+            }
+            y[j] = float(acc) * layer.output_scale[j] + layer.biases[j];
+        }
+    }
+}
+
+#ifdef UTEC_GEMM_X86
+
+// Cuantiza x[begin, min(begin + 8, end)) (el resto queda en cero)
+__attribute__((target("avx2,fma")))
+inline __m256i quantize_avx2(const float* x, const float* inverse_scale, size_t begin, size_t end) {
+    size_t remaining = end > begin ? std::min<size_t>(end - begin, 8) : 0;
+    __m256i mask = activation_detail::tail_mask_avx2(remaining);
+    __m256 v = _mm256_mul_ps(_mm256_maskload_ps(x + begin, mask), _mm256_maskload_ps(inverse_scale + begin, mask));
+    v = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(-127.0f)), _mm256_set1_ps(127.0f));
+    return _mm256_cvtps_epi32(v);
+}
+
+// AVX2: los int8 se extienden a int16 y vpmaddwd suma pares de productos
+// (sin saturación); al final se suman los dos parciales de cada salida
+__attribute__((target("avx2,fma")))
+inline void layer_avx2(const PackedLayer& layer, const float* x, size_t rows, float* y, int8_t* q) {
+    for (size_t r = 0; r < rows; ++r, x += layer.in, y += layer.out) {
+        for (size_t i = 0; i < layer.in; i += KB) {
+            __m256i words = _mm256_packs_epi32(quantize_avx2(x, layer.inverse_scale, i, layer.in),
+                                               quantize_avx2(x, layer.inverse_scale, i + 8, layer.in));
+            words = _mm256_permute4x64_epi64(words, 0xD8);
+            __m128i bytes = _mm_packs_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(q + i), bytes);
+        }
+
+        for (size_t j0 = 0; j0 < layer.out; j0 += 8) {
+            __m256i lo = _mm256_setzero_si256(), hi = _mm256_setzero_si256();
+            for (size_t g = 0; g < layer.groups; ++g) {
+                int32_t four;
+                std::memcpy(&four, q + 4 * g, sizeof(four));
+                __m256i xv = _mm256_cvtepi8_epi16(_mm_set1_epi32(four));
+                const int8_t* wg = layer.weights + (g * layer.out_padded + j0) * 4;
+                __m256i w0 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(wg)));
+                __m256i w1 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(wg + 16)));
+                lo = _mm256_add_epi32(lo, _mm256_madd_epi16(w0, xv));
+                hi = _mm256_add_epi32(hi, _mm256_madd_epi16(w1, xv));
+            }
+            // lo = [j0 j0 j1 j1 | j2 j2 j3 j3], hi igual con j4..j7
+            __m256i acc = _mm256_permute4x64_epi64(_mm256_hadd_epi32(lo, hi), 0xD8);
+            __m256 out = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(acc), _mm256_loadu_ps(layer.output_scale + j0)),
+                                       _mm256_loadu_ps(layer.biases + j0));
+            _mm256_maskstore_ps(y + j0, activation_detail::tail_mask_avx2(std::min<size_t>(layer.out - j0, 8)), out);
+        }
+    }
+}
+
+// AVX-512 VNNI: vpdpbusd con la entrada desplazada a u8 (x + 128)
+__attribute__((target("avx512f,avx512vnni")))
+inline void layer_vnni(const PackedLayer& layer, const float* x, size_t rows, float* y, int8_t* q) {
+    for (size_t r = 0; r < rows; ++r, x += layer.in, y += layer.out) {
+        for (size_t i = 0; i < layer.in; i += KB) {
+            __mmask16 mask = static_cast<__mmask16>(layer.in - i >= KB ? 0xFFFFu : (1u << (layer.in - i)) - 1u);
+            __m512 v = _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, x + i), _mm512_maskz_loadu_ps(mask, layer.inverse_scale + i));
+            // Variantes maskz con máscara completa: las sin máscara disparan un
+            // falso -Wmaybe-uninitialized en GCC 12 y compilan igual
+            v = _mm512_maskz_min_ps(0xFFFF, _mm512_maskz_max_ps(0xFFFF, v, _mm512_set1_ps(-127.0f)), _mm512_set1_ps(127.0f));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(q + i),
+                             _mm512_maskz_cvtepi32_epi8(0xFFFF, _mm512_maskz_cvtps_epi32(0xFFFF, v)));
+        }
+
+        for (size_t j0 = 0; j0 < layer.out; j0 += NR) {
+            __m512i sum = _mm512_setzero_si512();
+            for (size_t g = 0; g < layer.groups; ++g) {
+                int32_t four;
+                std::memcpy(&four, q + 4 * g, sizeof(four));
+                __m512i xv = _mm512_set1_epi32(four ^ int32_t(0x80808080u));
+                sum = _mm512_dpbusd_epi32(sum, xv, _mm512_loadu_si512(layer.weights + (g * layer.out_padded + j0) * 4));
+            }
+            __m512i acc = _mm512_sub_epi32(sum, _mm512_loadu_si512(layer.offsets + j0));
+            __m512 out = _mm512_add_ps(_mm512_mul_ps(_mm512_maskz_cvtepi32_ps(0xFFFF, acc), _mm512_loadu_ps(layer.output_scale + j0)),
+                                       _mm512_loadu_ps(layer.biases + j0));
+            size_t count = std::min<size_t>(layer.out - j0, NR);
+            _mm512_mask_storeu_ps(y + j0, static_cast<__mmask16>(count >= NR ? 0xFFFFu : (1u << count) - 1u), out);
+        }
+    }
+}
+
+#endif // UTEC_GEMM_X86
+
+// Kernel int8 para el conjunto de instrucciones activo de gemm.h
+inline LayerKernel layer_kernel() {
+#ifdef UTEC_GEMM_X86
+    static const bool vnni = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512vnni") != 0;
+    }();
+    switch (utec::algebra::gemm::active_isa()) {
+        case utec::algebra::gemm::Isa::avx512: return vnni ? layer_vnni : layer_avx2;
+        case utec::algebra::gemm::Isa::avx2:   return layer_avx2;
+        default: break;
+    }
+#endif
+    return layer_scalar;
+}
+
+} // namespace quantized_detail
+
+class QuantizedNetwork {
+public:
+    using Tensor2 = utec::algebra::Tensor<float, 2>;
+
+    // fp32, bf16 o fp16 (int8 necesita estados de calibración)
+    QuantizedNetwork(const NeuralNetwork<float>& network, Precision precision) : precision_(precision) {
+        if (precision == Precision::int8) {
+            throw std::invalid_argument("int8 quantization needs calibration states");
+        }
+        copy_layers(network);
+    }
+
+    // Cualquier precisión; con int8 las escalas se calibran con las filas
+    // de calibration (estados como los que verá la red)
+    QuantizedNetwork(const NeuralNetwork<float>& network, Precision precision, const Tensor2& calibration)
+        : precision_(precision) {
+        copy_layers(network);
+        if (precision == Precision::int8) {
+            const size_t cols = calibration.shape()[1];
+            calibrate(calibration.shape()[0], cols,
+                      [&calibration, cols](size_t r) { return calibration.data() + r * cols; });
+        }
+    }
+
+    QuantizedNetwork(const NeuralNetwork<float>& network, Precision precision, const ChunkedDataset<float>& calibration)
+        : precision_(precision) {
+        copy_layers(network);
+        if (precision == Precision::int8) {
+            calibrate(calibration.size(), calibration.input_cols(),
+                      [&calibration](size_t r) { return calibration.input(r); });
+        }
+    }
+
+    // Igual que NeuralNetwork::predict_batch: la referencia devuelta es
+    // válida hasta la siguiente llamada; tras la primera llamada con B filas
+    // no se asigna memoria. No es seguro llamarla desde varios hilos a la vez.
+    const Tensor2& predict_batch(const Tensor2& input) {
+        PROFILE_ZONE("QuantizedNetwork::predict_batch");
+        if (input.shape()[1] != input_size()) {
+            throw std::invalid_argument("Invalid input size for QuantizedNetwork");
+        }
+        return precision_ == Precision::int8 ? predict_int8(input) : predict_float(input);
+    }
+
+    Precision precision() const { return precision_; }
+    size_t input_size() const { return layers_.front().in; }
+    size_t output_size() const { return layers_.back().out; }
+
+    // Memoria de los pesos guardados (sin biases ni escalas)
+    size_t weight_bytes() const {
+        size_t bytes = 0;
+        for (const auto& layer : layers_) {
+            bytes += layer.weights.size() * sizeof(float) + layer.half.size() * sizeof(uint16_t) +
+                     layer.packed.size() * sizeof(int8_t);
+        }
+        return bytes;
+    }
+
+private:
+    struct Layer {
+        size_t in = 0, out = 0;
+        std::vector<float> weights;       // fp32: in x out
+        std::vector<uint16_t> half;       // bf16/fp16: in x out
+        std::vector<float> biases;
+
+        // int8
+        size_t groups = 0;                // ceil(in / 4)
+        size_t out_padded = 0;            // múltiplo de NR
+        std::vector<int8_t> packed;       // [groups][out_padded][4]
+        std::vector<int32_t> offsets;     // 128 * suma de cada columna de packed
+        std::vector<float> inverse_input_scale;  // x_q = round(x / escala), múltiplo de KB
+        std::vector<float> output_scale;  // y = acc * escala + bias, out_padded
+
+        quantized_detail::PackedLayer packed_view() const {
+            return {in, out, groups, out_padded, packed.data(), offsets.data(),
+                    inverse_input_scale.data(), output_scale.data(), biases.data()};
+        }
+    };
+
+    Precision precision_;
+    std::vector<Layer> layers_;
+
+    // Buffers reutilizados entre llamadas
+    Tensor2 buffers_[2];
+    std::vector<float> decoded_;
+    std::vector<int8_t> scratch_;
+
+    static void activate(const float* in, float* out, size_t n) { Tanh<float>::forward(in, out, n); }
+
+    void copy_layers(const NeuralNetwork<float>& network) {
+        const auto& layers = network.layers();
+        if (layers.empty() || layers.size() % 2 != 0) {
+            throw std::invalid_argument("QuantizedNetwork needs dense layers each followed by tanh");
+        }
+        for (size_t l = 0; l < layers.size(); l += 2) {
+            const auto* dense = dynamic_cast<const DenseLayer<float>*>(layers[l].get());
+            if (!dense || layers[l + 1]->type() != "activation_" + Tanh<float>::name() ||
+                (!layers_.empty() && layers_.back().out != dense->input_size())) {
+                throw std::invalid_argument("QuantizedNetwork needs dense layers each followed by tanh");
+            }
+            Layer layer;
+            layer.in = dense->input_size();
+            layer.out = dense->output_size();
+            const float* w = dense->weights();
+            layer.biases.assign(dense->biases(), dense->biases() + layer.out);
+            // Con int8 se conservan en fp32 hasta calibrar
+            if (precision_ == Precision::bf16 || precision_ == Precision::fp16) {
+                layer.half.resize(layer.in * layer.out);
+                for (size_t i = 0; i < layer.half.size(); ++i) {
+                    layer.half[i] = precision_ == Precision::bf16 ? to_bf16(w[i]) : to_fp16(w[i]);
+                }
+            } else {
+                layer.weights.assign(w, w + layer.in * layer.out);
+            }
+            layers_.push_back(std::move(layer));
+        }
+    }
+
+    // Máximo |x| por canal de entrada de cada capa, recorriendo la red en
+    // fp32 sobre las filas de calibración; luego cuantiza los pesos
+    template<typename Row>
+    void calibrate(size_t rows, size_t cols, Row&& row) {
+        if (rows == 0) {
+            throw std::invalid_argument("int8 quantization needs calibration states");
+        }
+        if (cols != input_size()) {
+            throw std::invalid_argument("Calibration states do not match the network input size");
+        }
+
+        std::vector<std::vector<float>> max_abs(layers_.size());
+        for (size_t l = 0; l < layers_.size(); ++l) max_abs[l].assign(layers_[l].in, 0.0f);
+
+        const size_t block = 256;
+        Tensor2 input;
+        for (size_t begin = 0; begin < rows; begin += block) {
+            size_t count = std::min(block, rows - begin);
+            input.resize(count, cols);
+            for (size_t r = 0; r < count; ++r) {
+                std::copy_n(row(begin + r), cols, input.data() + r * cols);
+            }
+            const Tensor2* current = &input;
+            for (size_t l = 0; l < layers_.size(); ++l) {
+                const Layer& layer = layers_[l];
+                for (size_t r = 0; r < count; ++r) {
+                    const float* x = current->data() + r * layer.in;
+                    for (size_t i = 0; i < layer.in; ++i) {
+                        max_abs[l][i] = std::max(max_abs[l][i], std::fabs(x[i]));
+                    }
+                }
+                Tensor2& output = buffers_[l % 2];
+                output.resize(count, layer.out);
+                utec::algebra::gemm::gemm<float>(count, layer.out, layer.in, current->data(), layer.in,
+                                                 layer.weights.data(), layer.out, output.data(), layer.out,
+                                                 {layer.biases.data(), &QuantizedNetwork::activate});
+                current = &output;
+            }
+        }
+
+        for (size_t l = 0; l < layers_.size(); ++l) {
+            quantize_layer(layers_[l], max_abs[l]);
+        }
+    }
+
+    static void quantize_layer(Layer& layer, const std::vector<float>& max_abs) {
+        using quantized_detail::NR;
+        using quantized_detail::KB;
+        layer.groups = (layer.in + 3) / 4;
+        layer.out_padded = (layer.out + NR - 1) / NR * NR;
+
+        // Escala de cada canal de entrada absorbida en los pesos:
+        // x * w = (x / s) * (w * s)
+        std::vector<float> input_scale(layer.in);
+        layer.inverse_input_scale.assign((layer.in + KB - 1) / KB * KB, 0.0f);
+        for (size_t i = 0; i < layer.in; ++i) {
+            input_scale[i] = max_abs[i] > 0.0f ? max_abs[i] / 127.0f : 1.0f;
+            layer.inverse_input_scale[i] = 1.0f / input_scale[i];
+        }
+
+        layer.output_scale.assign(layer.out_padded, 1.0f);
+        layer.biases.resize(layer.out_padded, 0.0f);
+        for (size_t j = 0; j < layer.out; ++j) {
+            float max_weight = 0.0f;
+            for (size_t i = 0; i < layer.in; ++i) {
+                max_weight = std::max(max_weight, std::fabs(layer.weights[i * layer.out + j] * input_scale[i]));
+            }
+            if (max_weight > 0.0f) layer.output_scale[j] = max_weight / 127.0f;
+        }
+
+        layer.packed.assign(layer.groups * layer.out_padded * 4, 0);
+        layer.offsets.assign(layer.out_padded, 0);
+        for (size_t i = 0; i < layer.in; ++i) {
+            for (size_t j = 0; j < layer.out; ++j) {
+                float w = layer.weights[i * layer.out + j] * input_scale[i];
+                int8_t q = quantized_detail::quantize(w, 1.0f / layer.output_scale[j]);
+                layer.packed[((i / 4) * layer.out_padded + j) * 4 + i % 4] = q;
+                layer.offsets[j] += 128 * q;
+            }
+        }
+        layer.weights.clear();
+        layer.weights.shrink_to_fit();
+    }
+
+    const Tensor2& predict_float(const Tensor2& input) {
+        const size_t rows = input.shape()[0];
+        const Tensor2* current = &input;
+        for (size_t l = 0; l < layers_.size(); ++l) {
+            const Layer& layer = layers_[l];
+            const float* weights = layer.weights.data();
+            if (!layer.half.empty()) {
+                decoded_.resize(layer.half.size());
+                for (size_t i = 0; i < layer.half.size(); ++i) {
+                    decoded_[i] = precision_ == Precision::bf16 ? from_bf16(layer.half[i]) : from_fp16(layer.half[i]);
+                }
+                weights = decoded_.data();
+            }
+            Tensor2& output = buffers_[l % 2];
+            output.resize(rows, layer.out);
+            utec::algebra::gemm::gemm<float>(rows, layer.out, layer.in, current->data(), layer.in,
+                                             weights, layer.out, output.data(), layer.out,
+                                             {layer.biases.data(), &QuantizedNetwork::activate});
+            current = &output;
+        }
+        return *current;
+    }
+
+    const Tensor2& predict_int8(const Tensor2& input) {
+        const size_t rows = input.shape()[0];
+        const auto kernel = quantized_detail::layer_kernel();
+        const Tensor2* current = &input;
+        for (size_t l = 0; l < layers_.size(); ++l) {
+            const Layer& layer = layers_[l];
+            Tensor2& output = buffers_[l % 2];
+            output.resize(rows, layer.out);
+            scratch_.resize(layer.inverse_input_scale.size());
+            kernel(layer.packed_view(), current->data(), rows, output.data(), scratch_.data());
+            // La tanh en un recorrido aparte se vectoriza mejor que dentro del kernel
+            activate(output.data(), output.data(), output.size());
+            current = &output;
+        }
+        return *current;
+    }
+};
+
+} // namespace neural_network
+} // namespace utec
+
+#endif // NN_QUANTIZED_H
@@ -0,0 +1,136 @@
+#ifndef NN_RANDOM_H
+#define NN_RANDOM_H
+
+// Números aleatorios reproducibles para todo el proyecto. SplitMix64 es un
+// generador basado en contador: el valor i-ésimo es mix64(semilla + i·γ),
+// así que saltar n valores cuesta lo mismo que generar uno (discard) y un
+// flujo se describe con 8 bytes. stream_seed(semilla, id) deriva flujos
+// independientes baratos para cada hilo, partida o capa.
+//
+// Lo que no recibe un generador explícito (inicialización de capas,
+// Tensor::random_fill, barajado de NeuralNetwork) toma el siguiente flujo
+// del generador global con next_stream(). Con la misma semilla global
+// (seed()) y el mismo número de hilos, un entrenamiento completo se repite
+// bit a bit. Las distribuciones están implementadas aquí y no con <random>,
+// cuyo resultado depende de la biblioteca estándar.
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+namespace utec {
+namespace random {
+
+constexpr uint64_t default_seed = 5489;
+
+// Incremento de Weyl de SplitMix64 (parte fraccionaria de la razón áurea)
+constexpr uint64_t golden_gamma = 0x9E3779B97F4A7C15ull;
+
+// Función de mezcla de SplitMix64: biyectiva, con buena avalancha
+constexpr uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Generador SplitMix64 de 8 bytes: útil cuando hay miles de partidas y cada
+// una necesita su propio flujo (p.ej. VectorEnv). Cumple los requisitos de
+// UniformRandomBitGenerator.
+struct SplitMix64 {
+    using result_type = uint64_t;
+    uint64_t state;
+
+    explicit SplitMix64(uint64_t seed = 0) : state(seed) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type{0}; }
+
+    result_type operator()() {
+        return mix64(state += golden_gamma);
+    }
+
+    // Salta n valores en O(1)
+    void discard(uint64_t n) { state += n * golden_gamma; }
+};
+
+// Semilla del flujo `stream` derivado de `seed`: flujos distintos no se
+// solapan en la práctica aunque las semillas o los ids sean consecutivos
+constexpr uint64_t stream_seed(uint64_t seed, uint64_t stream) {
+    return mix64(seed ^ mix64(stream + golden_gamma));
+}
+
+inline SplitMix64 make_stream(uint64_t seed, uint64_t stream) {
+    return SplitMix64(stream_seed(seed, stream));
+}
+
+// Uniforme en [0, 1) con los bits altos (24 para float, 53 para double)
+template<typename T, typename Gen>
+T uniform01(Gen& rng) {
+    static_assert(std::is_floating_point_v<T>);
+    if constexpr (sizeof(T) <= sizeof(float)) {
+        return T(float(rng() >> 40) * (1.0f / 16777216.0f));
+    } else {
+        return T(double(rng() >> 11) * (1.0 / 9007199254740992.0));
+    }
+}
+
+template<typename T, typename Gen>
+T uniform(Gen& rng, T min, T max) {
+    return min + (max - min) * uniform01<T>(rng);
+}
+
+// Entero en [0, n) (el sesgo de % es menor que n / 2^64)
+template<typename Gen>
+uint64_t below(Gen& rng, uint64_t n) {
+    return rng() % n;
+}
+
+// N(0, 1) por Box-Muller; usa dos valores del generador por muestra
+template<typename T, typename Gen>
+T normal(Gen& rng) {
+    double u1 = 1.0 - uniform01<double>(rng);   // (0, 1]: log finito
+    double u2 = uniform01<double>(rng);
+    return T(std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2));
+}
+
+// Fisher-Yates con below(): la misma permutación en cualquier plataforma
+template<typename It, typename Gen>
+void shuffle(It first, It last, Gen& rng) {
+    auto n = last - first;
+    for (auto i = n - 1; i > 0; --i) {
+        using std::swap;
+        swap(first[i], first[below(rng, uint64_t(i) + 1)]);
+    }
+}
+
+namespace detail {
+inline std::atomic<uint64_t> global_seed{default_seed};
+inline std::atomic<uint64_t> next_stream{0};
+}
+
+// Fija la semilla global y reinicia la cuenta de flujos: lo que se cree
+// después (redes, capas, tensores aleatorios) se repite igual
+inline void seed(uint64_t value) {
+    detail::global_seed.store(value, std::memory_order_relaxed);
+    detail::next_stream.store(0, std::memory_order_relaxed);
+}
+
+inline uint64_t global_seed() {
+    return detail::global_seed.load(std::memory_order_relaxed);
+}
+
+// El siguiente flujo del generador global. El orden de las llamadas define
+// los flujos, así que hay que pedirlos desde un solo hilo (o en un orden
+// fijo) para que el resultado sea reproducible.
+inline SplitMix64 next_stream() {
+    uint64_t id = detail::next_stream.fetch_add(1, std::memory_order_relaxed);
+    return make_stream(global_seed(), id);
+}
+
+} // namespace random
+} // namespace utec
+
+#endif // NN_RANDOM_H
@@ -0,0 +1,200 @@
+#ifndef NN_SERIALIZATION_H
+#define NN_SERIALIZATION_H
+
+// Formato binario de los modelos (NeuralNetwork::save / load).
+//
+//   [ModelHeader, 64 bytes]
+//   [LayerRecord x layer_count, 64 bytes cada uno]
+//   [blobs de pesos y biases, cada uno alineado a 64 bytes]
+//
+// Los números se guardan en el orden de bytes de la máquina (byte_order
+// permite detectar un archivo de otra arquitectura). El checksum es FNV-1a
+// de todo el archivo con el campo checksum en cero. Al cargar, el archivo
+// se mapea en memoria (mmap) y las capas densas leen sus pesos directamente
+// del mapeo, sin copiarlos.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define UTEC_HAS_MMAP 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace utec {
+namespace neural_network {
+namespace serialization {
+
+constexpr char magic[8] = {'P', 'S', 'N', 'N', 'M', 'D', 'L', '\0'};
+constexpr uint32_t format_version = 1;
+constexpr uint32_t byte_order_mark = 0x01020304;
+constexpr size_t blob_alignment = 64;
+
+struct ModelHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t scalar_size;     // sizeof(T) de la red guardada
+    uint32_t layer_count;
+    uint64_t file_size;
+    uint64_t checksum;
+    uint8_t reserved[24];
+};
+static_assert(sizeof(ModelHeader) == 64, "ModelHeader must be 64 bytes");
+
+struct LayerRecord {
+    char type[32];            // Layer::type(), p.ej. "dense" o "activation_tanh"
+    uint64_t rows;            // forma de los pesos (0 si la capa no tiene)
+    uint64_t cols;
+    uint64_t weights_offset;  // desde el inicio del archivo
+    uint64_t bias_offset;
+};
+static_assert(sizeof(LayerRecord) == 64, "LayerRecord must be 64 bytes");
+
+inline size_t align_up(size_t n) {
+    return (n + blob_alignment - 1) / blob_alignment * blob_alignment;
+}
+
+inline uint64_t fnv1a(const unsigned char* bytes, size_t count, uint64_t hash = 1469598103934665603ull) {
+    for (size_t i = 0; i < count; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// Checksum del archivo completo tomando el campo checksum como cero
+inline uint64_t file_checksum(const unsigned char* bytes, size_t size) {
+    const size_t field = offsetof(ModelHeader, checksum);
+    const unsigned char zeros[sizeof(uint64_t)] = {};
+    uint64_t hash = fnv1a(bytes, field);
+    hash = fnv1a(zeros, sizeof(zeros), hash);
+    return fnv1a(bytes + field + sizeof(uint64_t), size - field - sizeof(uint64_t), hash);
+}
+
+// Archivo de sólo lectura mapeado en memoria. Donde no hay mmap se lee
+// completo a un buffer alineado.
+class MappedFile {
+private:
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef UTEC_HAS_MMAP
+    void* mapping_ = nullptr;
+#else
+    std::vector<std::max_align_t> buffer_;
+#endif
+
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef UTEC_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open model file: " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot stat model file: " + path);
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0) {
+            mapping_ = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if (mapping_ == MAP_FAILED) {
+            mapping_ = nullptr;
+            throw std::runtime_error("Cannot map model file: " + path);
+        }
+        data_ = static_cast<const unsigned char*>(mapping_);
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            throw std::runtime_error("Cannot open model file: " + path);
+        }
+        size_ = static_cast<size_t>(file.tellg());
+        buffer_.resize((size_ + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(buffer_.data()), size_);
+        data_ = reinterpret_cast<const unsigned char*>(buffer_.data());
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef UTEC_HAS_MMAP
+        if (mapping_) ::munmap(mapping_, size_);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return data_; }
+    size_t size() const { return size_; }
+};
+
+// Valida cabecera y checksum; devuelve la cabecera
+inline const ModelHeader& check_header(const MappedFile& file, uint32_t scalar_size) {
+    if (file.size() < sizeof(ModelHeader)) {
+        throw std::runtime_error("Model file too small");
+    }
+    const auto& header = *reinterpret_cast<const ModelHeader*>(file.data());
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+        throw std::runtime_error("Not a model file (bad magic)");
+    }
+    if (header.version != format_version) {
+        throw std::runtime_error("Unsupported model format version " + std::to_string(header.version));
+    }
+    if (header.byte_order != byte_order_mark) {
+        throw std::runtime_error("Model file has a different byte order");
+    }
+    if (header.scalar_size != scalar_size) {
+        throw std::runtime_error("Model file was saved with a different scalar type");
+    }
+    if (header.file_size != file.size() ||
+        sizeof(ModelHeader) + header.layer_count * sizeof(LayerRecord) > file.size()) {
+        throw std::runtime_error("Model file is truncated");
+    }
+    if (header.checksum != file_checksum(file.data(), file.size())) {
+        throw std::runtime_error("Model file checksum mismatch");
+    }
+    return header;
+}
+
+// Puntero a un blob de count elementos; comprueba rango y alineación
+template<typename T>
+const T* blob(const MappedFile& file, uint64_t offset, size_t count) {
+    if (offset % blob_alignment != 0 || offset > file.size() ||
+        count > (file.size() - offset) / sizeof(T)) {
+        throw std::runtime_error("Model file has an invalid weight blob");
+    }
+    return reinterpret_cast<const T*>(file.data() + offset);
+}
+
+// Escribe un archivo ya armado en memoria (calcula el checksum)
+inline void write_file(const std::string& path, std::vector<unsigned char>& bytes) {
+    auto* header = reinterpret_cast<ModelHeader*>(bytes.data());
+    header->file_size = bytes.size();
+    header->checksum = file_checksum(bytes.data(), bytes.size());
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Cannot create model file: " + path);
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    if (!file) {
+        throw std::runtime_error("Cannot write model file: " + path);
+    }
+}
+
+} // namespace serialization
+} // namespace neural_network
+} // namespace utec
+
+#endif // NN_SERIALIZATION_H
@@ -0,0 +1,115 @@
+#ifndef NN_SPSC_QUEUE_H
+#define NN_SPSC_QUEUE_H
+
+// Cola acotada sin locks para un productor y un consumidor (SPSC): el
+// productor sólo escribe tail y el consumidor sólo escribe head, así que
+// basta con un par de atómicos con acquire/release. La memoria se reserva
+// al construirla; try_push/try_pop/consume nunca asignan ni bloquean.
+//
+// Lo de cada lado vive en su propia línea de caché (sin false sharing), y
+// cada lado guarda la última posición que vio del otro: sólo relee el
+// atómico ajeno cuando la cola parece llena (productor) o vacía
+// (consumidor), así que en el caso normal no hay tráfico entre núcleos.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <stdexcept>
+
+namespace utec {
+namespace parallel {
+
+template<typename T>
+class SpscQueue {
+private:
+    static constexpr size_t cache_line = 64;
+
+    struct alignas(cache_line) Producer {
+        std::atomic<size_t> tail{0};       // siguiente a escribir
+        size_t head_cache = 0;             // último head visto
+        std::atomic<uint64_t> dropped{0};  // descartadas por cola llena
+    };
+
+    struct alignas(cache_line) Consumer {
+        std::atomic<size_t> head{0};       // siguiente a leer
+        size_t tail_cache = 0;             // último tail visto
+    };
+
+    Producer producer_;
+    Consumer consumer_;
+    std::vector<T> slots_;
+    size_t mask_;
+
+public:
+    // capacity debe ser potencia de dos
+    explicit SpscQueue(size_t capacity) : slots_(capacity), mask_(capacity - 1) {
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+            throw std::invalid_argument("SpscQueue capacity must be a power of two");
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Sólo el productor. Si la cola está llena el valor se descarta, se
+    // cuenta en dropped() y devuelve false
+    bool try_push(const T& value) {
+        size_t tail = producer_.tail.load(std::memory_order_relaxed);
+        if (tail - producer_.head_cache == slots_.size()) {
+            producer_.head_cache = consumer_.head.load(std::memory_order_acquire);
+            if (tail - producer_.head_cache == slots_.size()) {
+                producer_.dropped.store(producer_.dropped.load(std::memory_order_relaxed) + 1,
+                                        std::memory_order_relaxed);
+                return false;
+            }
+        }
+        slots_[tail & mask_] = value;
+        producer_.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Sólo el consumidor. false si la cola está vacía
+    bool try_pop(T& value) {
+        size_t head = consumer_.head.load(std::memory_order_relaxed);
+        if (head == consumer_.tail_cache) {
+            consumer_.tail_cache = producer_.tail.load(std::memory_order_acquire);
+            if (head == consumer_.tail_cache) return false;
+        }
+        value = slots_[head & mask_];
+        consumer_.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Sólo el consumidor: llama a f(const T&) con hasta `max` elementos
+    // disponibles y los libera de una vez; devuelve cuántos fueron
+    template<typename F>
+    size_t consume(F&& f, size_t max = std::numeric_limits<size_t>::max()) {
+        size_t head = consumer_.head.load(std::memory_order_relaxed);
+        consumer_.tail_cache = producer_.tail.load(std::memory_order_acquire);
+        size_t count = std::min(consumer_.tail_cache - head, max);
+        for (size_t i = 0; i < count; ++i) {
+            f(static_cast<const T&>(slots_[(head + i) & mask_]));
+        }
+        consumer_.head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Aproximado si el otro hilo está trabajando
+    size_t size() const {
+        return producer_.tail.load(std::memory_order_acquire) - consumer_.head.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return slots_.size(); }
+
+    // Contadores del productor (se pueden leer desde cualquier hilo)
+    uint64_t pushed() const { return producer_.tail.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return producer_.dropped.load(std::memory_order_relaxed); }
+};
+
+} // namespace parallel
+} // namespace utec
+
+#endif // NN_SPSC_QUEUE_H
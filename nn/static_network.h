@@ -0,0 +1,188 @@
+#ifndef NN_STATIC_NETWORK_H
+#define NN_STATIC_NETWORK_H
+
+// Red de arquitectura fija para inferencia: StaticNetwork<float, 5, 16, 16, 1>
+// es una red densa 5 -> 16 -> 16 -> 1 con tanh después de cada capa (la
+// política del AIPaddle). Todos los tamaños se conocen al compilar: los
+// pesos viven dentro del objeto (sin memoria dinámica), los bucles tienen
+// longitud constante y no hay llamadas virtuales. Sólo sirve para predecir;
+// para entrenar se usa NeuralNetwork y luego se copian los pesos.
+
+#include "network.h"
+#include "activation.h"
+#include "serialization.h"
+#include "profiler.h"
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+
+namespace utec {
+namespace neural_network {
+
+namespace static_detail {
+
+// Capa densa In -> Out seguida de tanh
+template<typename T, size_t In, size_t Out>
+struct DenseTanh {
+    alignas(64) std::array<T, In * Out> weights{};  // row-major In x Out
+    alignas(64) std::array<T, Out> biases{};
+
+    void forward(const T* input, T* output) const {
+        // Acumulador local de longitud constante: el compilador lo vectoriza
+        // y desenrolla por completo
+        alignas(64) std::array<T, Out> sum = biases;
+        for (size_t i = 0; i < In; ++i) {
+            const T x = input[i];
+            const T* row = weights.data() + i * Out;
+            for (size_t j = 0; j < Out; ++j) {
+                sum[j] += x * row[j];
+            }
+        }
+        Tanh<T>::forward(sum.data(), output, Out);
+    }
+
+    void assign(const T* w, const T* b) {
+        std::copy_n(w, weights.size(), weights.begin());
+        std::copy_n(b, biases.size(), biases.begin());
+    }
+};
+
+// Cadena de capas para los tamaños S0 -> S1 -> ... (recursiva)
+template<typename T, size_t... Sizes>
+struct Layers;
+
+template<typename T, size_t In, size_t Out>
+struct Layers<T, In, Out> {
+    static constexpr size_t count = 1;
+    DenseTanh<T, In, Out> layer;
+
+    void forward(const T* input, T* output) const { layer.forward(input, output); }
+
+    template<typename Visitor>
+    void visit(Visitor&& visitor) { visitor(In, Out, layer); }
+};
+
+template<typename T, size_t In, size_t Hidden, size_t... Rest>
+struct Layers<T, In, Hidden, Rest...> {
+    static constexpr size_t count = 1 + Layers<T, Hidden, Rest...>::count;
+    DenseTanh<T, In, Hidden> layer;
+    Layers<T, Hidden, Rest...> rest;
+
+    void forward(const T* input, T* output) const {
+        alignas(64) T hidden[Hidden];
+        layer.forward(input, hidden);
+        rest.forward(hidden, output);
+    }
+
+    template<typename Visitor>
+    void visit(Visitor&& visitor) {
+        visitor(In, Hidden, layer);
+        rest.visit(visitor);
+    }
+};
+
+} // namespace static_detail
+
+template<typename T, size_t... Sizes>
+class StaticNetwork {
+    static_assert(sizeof...(Sizes) >= 2, "StaticNetwork needs at least an input and an output size");
+
+public:
+    static constexpr std::array<size_t, sizeof...(Sizes)> sizes{Sizes...};
+    static constexpr size_t input_size = sizes.front();
+    static constexpr size_t output_size = sizes.back();
+    static constexpr size_t layer_count = static_detail::Layers<T, Sizes...>::count;
+    static constexpr size_t parameter_count = [] {
+        size_t count = 0;
+        for (size_t l = 0; l + 1 < sizes.size(); ++l) count += (sizes[l] + 1) * sizes[l + 1];
+        return count;
+    }();
+
+    using Input = std::array<T, input_size>;
+    using Output = std::array<T, output_size>;
+
+private:
+    static_detail::Layers<T, Sizes...> layers_;
+
+public:
+    // Red con pesos en cero (predice tanh(0) = 0)
+    StaticNetwork() = default;
+
+    // Copia los pesos de una red entrenada con la misma arquitectura:
+    // capas densas de estos tamaños, cada una seguida de tanh
+    explicit StaticNetwork(const NeuralNetwork<T>& network) {
+        assign(network);
+    }
+
+    void assign(const NeuralNetwork<T>& network) {
+        const auto& layers = network.layers();
+        if (layers.size() != 2 * layer_count) {
+            throw std::invalid_argument("Network architecture does not match StaticNetwork");
+        }
+        size_t l = 0;
+        layers_.visit([&](size_t in, size_t out, auto& layer) {
+            const auto* dense = dynamic_cast<const DenseLayer<T>*>(layers[l].get());
+            if (!dense || dense->input_size() != in || dense->output_size() != out ||
+                layers[l + 1]->type() != "activation_" + Tanh<T>::name()) {
+                throw std::invalid_argument("Network architecture does not match StaticNetwork");
+            }
+            layer.assign(dense->weights(), dense->biases());
+            l += 2;
+        });
+    }
+
+    // Copia parameter_count valores en el orden de
+    // NeuralNetwork::get_parameters (por capa, pesos y luego biases)
+    void assign(const T* parameters) {
+        layers_.visit([&](size_t in, size_t out, auto& layer) {
+            layer.assign(parameters, parameters + in * out);
+            parameters += in * out + out;
+        });
+    }
+
+    // Carga un modelo guardado con NeuralNetwork::save sin construir la red
+    // dinámica; los pesos se copian y el archivo se cierra al terminar
+    void load(const std::string& path) {
+        namespace io = serialization;
+
+        io::MappedFile file(path);
+        const io::ModelHeader& header = io::check_header(file, sizeof(T));
+        const auto* records = reinterpret_cast<const io::LayerRecord*>(file.data() + sizeof(io::ModelHeader));
+        if (header.layer_count != 2 * layer_count) {
+            throw std::runtime_error("Model file architecture does not match StaticNetwork");
+        }
+
+        auto type = [](const io::LayerRecord& record) {
+            return std::string(record.type, std::find(record.type, record.type + sizeof(record.type), '\0'));
+        };
+
+        // Se valida todo antes de copiar: ante un error la red no cambia
+        StaticNetwork loaded;
+        size_t l = 0;
+        loaded.layers_.visit([&](size_t in, size_t out, auto& layer) {
+            const io::LayerRecord& dense = records[l];
+            if (type(dense) != "dense" || dense.rows != in || dense.cols != out ||
+                type(records[l + 1]) != "activation_" + Tanh<T>::name()) {
+                throw std::runtime_error("Model file architecture does not match StaticNetwork");
+            }
+            layer.assign(io::blob<T>(file, dense.weights_offset, in * out),
+                         io::blob<T>(file, dense.bias_offset, out));
+            l += 2;
+        });
+        *this = loaded;
+    }
+
+    Output predict(const Input& input) const {
+        PROFILE_ZONE("StaticNetwork::predict");
+        Output output;
+        layers_.forward(input.data(), output.data());
+        return output;
+    }
+};
+
+} // namespace neural_network
+} // namespace utec
+
+#endif // NN_STATIC_NETWORK_H
@@ -6,54 +6,95 @@
 #define NN_TENSOR_H
 
 #include <vector>
+#include <array>
 #include <stdexcept>
 #include <numeric>
 #include <algorithm>
 #include <functional>
 #include <cmath>
 #include <iostream>
-#include <random>
+#include <type_traits>
+#include "gemm.h"
+#include "expression.h"
+#include "random.h"
 
 namespace utec {
 namespace algebra {
 
+// Las comprobaciones de rango en operator() sólo se activan en builds de
+// depuración; at() siempre comprueba.
+#if !defined(UTEC_TENSOR_BOUNDS_CHECK) && !defined(NDEBUG)
+#define UTEC_TENSOR_BOUNDS_CHECK 1
+#endif
+
+// Vista 2D sin dueño sobre memoria contigua en row-major (p.ej. un trozo
+// del workspace de la red). Copiarla no copia los datos.
+template<typename T>
+struct MatrixView {
+    T* data = nullptr;
+    size_t rows = 0;
+    size_t cols = 0;
+
+    MatrixView() = default;
+    MatrixView(T* data, size_t rows, size_t cols) : data(data), rows(rows), cols(cols) {}
+
+    // Una vista mutable se puede pasar donde se espera una de sólo lectura
+    template<typename U>
+        requires (std::is_same_v<T, const U>)
+    MatrixView(const MatrixView<U>& other) : data(other.data), rows(other.rows), cols(other.cols) {}
+
+    T& operator()(size_t i, size_t j) const { return data[i * cols + j]; }
+    size_t size() const { return rows * cols; }
+    bool empty() const { return data == nullptr; }
+};
+
+// +, - y * por escalar devuelven expresiones perezosas (ver expression.h)
+// que se evalúan en un solo recorrido al asignarlas a un Tensor.
 template<typename T, size_t N>
-class Tensor {
+class Tensor : public Expression<Tensor<T, N>, T, N> {
 private:
     std::vector<T> data_;
-    std::vector<size_t> shape_;
-    std::vector<size_t> strides_;
+    std::array<size_t, N> shape_{};
+    std::array<size_t, N> strides_{};
 
     void calculate_strides() {
-        strides_.resize(N);
-        if (N > 0) {
+        if constexpr (N > 0) {
             strides_[N-1] = 1;
-            for (int i = N-2; i >= 0; --i) {
+            for (size_t i = N-1; i-- > 0;) {
                 strides_[i] = strides_[i+1] * shape_[i+1];
             }
         }
     }
 
-    size_t get_index(const std::vector<size_t>& indices) const {
-        size_t idx = 0;
+    // Índice lineal sin comprobaciones; el bucle sobre N se desenrolla
+    template<typename... Idx>
+    size_t offset(Idx... indices) const noexcept {
+        const size_t idx[] = {static_cast<size_t>(indices)...};
+        size_t off = 0;
+        for (size_t i = 0; i < N; ++i) {
+            off += idx[i] * strides_[i];
+        }
+        return off;
+    }
+
+    template<typename... Idx>
+    void check_bounds(Idx... indices) const {
+        const size_t idx[] = {static_cast<size_t>(indices)...};
         for (size_t i = 0; i < N; ++i) {
-            if (indices[i] >= shape_[i]) {
+            if (idx[i] >= shape_[i]) {
                 throw std::out_of_range("Index out of bounds");
             }
-            idx += indices[i] * strides_[i];
         }
-        return idx;
     }
 
 public:
     // Constructor por defecto
-    Tensor() : shape_(N, 0), strides_(N, 0) {}
+    Tensor() = default;
 
     // Constructor con forma específica
     template<typename... Args>
+        requires (sizeof...(Args) == N && (std::is_integral_v<Args> && ...))
     Tensor(Args... dimensions) : shape_{static_cast<size_t>(dimensions)...} {
-        static_assert(sizeof...(dimensions) == N, "Number of dimensions must match template parameter");
-
         size_t total_size = 1;
         for (size_t dim : shape_) {
             total_size *= dim;
@@ -66,9 +107,8 @@ public:
 
     // Constructor con inicialización
     template<typename... Args>
+        requires (sizeof...(Args) == N && (std::is_integral_v<Args> && ...))
     Tensor(T init_value, Args... dimensions) : shape_{static_cast<size_t>(dimensions)...} {
-        static_assert(sizeof...(dimensions) == N, "Number of dimensions must match template parameter");
-
         size_t total_size = 1;
         for (size_t dim : shape_) {
             total_size *= dim;
@@ -78,63 +118,105 @@ public:
         calculate_strides();
     }
 
-    // Acceso a elementos (para 2D)
-    T& operator()(size_t i, size_t j) {
-        static_assert(N == 2, "This operator is only for 2D tensors");
-        return data_[get_index({i, j})];
+    // Evalúa una expresión (a + b * s, ...) en un solo recorrido
+    template<typename E>
+        requires (TensorExpression<E> && !std::is_same_v<std::remove_cvref_t<E>, Tensor> &&
+                  std::is_same_v<typename E::value_type, T> && E::rank == N)
+    Tensor(const E& expression) : data_(expression.size()), shape_(expression.shape()) {
+        calculate_strides();
+        expression_detail::evaluate<expression_detail::Assign>(data_.data(), expression, data_.size());
+    }
+
+    // Reutiliza la memoria si la forma no cambia; la expresión puede
+    // contener a este mismo tensor (a = a * 2 + b)
+    template<typename E>
+        requires (TensorExpression<E> && !std::is_same_v<std::remove_cvref_t<E>, Tensor> &&
+                  std::is_same_v<typename E::value_type, T> && E::rank == N)
+    Tensor& operator=(const E& expression) {
+        if (shape_ != expression.shape()) {
+            shape_ = expression.shape();
+            data_.resize(expression.size());
+            calculate_strides();
+        }
+        expression_detail::evaluate<expression_detail::Assign>(data_.data(), expression, data_.size());
+        return *this;
     }
 
-    const T& operator()(size_t i, size_t j) const {
-        static_assert(N == 2, "This operator is only for 2D tensors");
-        return data_[get_index({i, j})];
+    Tensor(const Tensor&) = default;
+    Tensor(Tensor&&) noexcept = default;
+    Tensor& operator=(const Tensor&) = default;
+    Tensor& operator=(Tensor&&) noexcept = default;
+
+    // Acceso a elementos (cualquier rango). Sin comprobación de rango en
+    // Release; usar at() cuando se necesite validar los índices.
+    template<typename... Idx>
+    T& operator()(Idx... indices) {
+        static_assert(sizeof...(Idx) == N, "Number of indices must match tensor rank");
+#ifdef UTEC_TENSOR_BOUNDS_CHECK
+        check_bounds(indices...);
+#endif
+        return data_[offset(indices...)];
     }
 
-    // Acceso a elementos (para 1D)
-    T& operator()(size_t i) {
-        static_assert(N == 1, "This operator is only for 1D tensors");
-        return data_[i];
+    template<typename... Idx>
+    const T& operator()(Idx... indices) const {
+        static_assert(sizeof...(Idx) == N, "Number of indices must match tensor rank");
+#ifdef UTEC_TENSOR_BOUNDS_CHECK
+        check_bounds(indices...);
+#endif
+        return data_[offset(indices...)];
     }
 
-    const T& operator()(size_t i) const {
-        static_assert(N == 1, "This operator is only for 1D tensors");
-        return data_[i];
+    // Acceso con comprobación de rango siempre activa
+    template<typename... Idx>
+    T& at(Idx... indices) {
+        static_assert(sizeof...(Idx) == N, "Number of indices must match tensor rank");
+        check_bounds(indices...);
+        return data_[offset(indices...)];
+    }
+
+    template<typename... Idx>
+    const T& at(Idx... indices) const {
+        static_assert(sizeof...(Idx) == N, "Number of indices must match tensor rank");
+        check_bounds(indices...);
+        return data_[offset(indices...)];
     }
 
     // Métodos de información
-    const std::vector<size_t>& shape() const { return shape_; }
+    const std::array<size_t, N>& shape() const { return shape_; }
+    const std::array<size_t, N>& strides() const { return strides_; }
     size_t size() const { return data_.size(); }
 
-    // Operaciones matemáticas
-    Tensor<T, N> operator+(const Tensor<T, N>& other) const {
-        if (shape_ != other.shape_) {
-            throw std::invalid_argument("Tensor shapes must match for addition");
-        }
+    // Elemento i en orden row-major (el acceso de las expresiones)
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
 
-        Tensor<T, N> result = *this;
-        for (size_t i = 0; i < data_.size(); ++i) {
-            result.data_[i] += other.data_[i];
+    // Asignaciones compuestas: en el lugar, sin memoria nueva
+    template<typename E>
+        requires (TensorExpression<E> && std::is_same_v<typename std::remove_cvref_t<E>::value_type, T> &&
+                  std::remove_cvref_t<E>::rank == N)
+    Tensor& operator+=(const E& expression) {
+        if (shape_ != expression.shape()) {
+            throw std::invalid_argument("Tensor shapes must match for addition");
         }
-        return result;
+        expression_detail::evaluate<expression_detail::Add>(data_.data(), expression, data_.size());
+        return *this;
     }
 
-    Tensor<T, N> operator-(const Tensor<T, N>& other) const {
-        if (shape_ != other.shape_) {
+    template<typename E>
+        requires (TensorExpression<E> && std::is_same_v<typename std::remove_cvref_t<E>::value_type, T> &&
+                  std::remove_cvref_t<E>::rank == N)
+    Tensor& operator-=(const E& expression) {
+        if (shape_ != expression.shape()) {
             throw std::invalid_argument("Tensor shapes must match for subtraction");
         }
-
-        Tensor<T, N> result = *this;
-        for (size_t i = 0; i < data_.size(); ++i) {
-            result.data_[i] -= other.data_[i];
-        }
-        return result;
+        expression_detail::evaluate<expression_detail::Subtract>(data_.data(), expression, data_.size());
+        return *this;
     }
 
-    Tensor<T, N> operator*(T scalar) const {
-        Tensor<T, N> result = *this;
-        for (size_t i = 0; i < data_.size(); ++i) {
-            result.data_[i] *= scalar;
-        }
-        return result;
+    Tensor& operator*=(T scalar) {
+        expression_detail::evaluate<expression_detail::Assign>(data_.data(), *this * scalar, data_.size());
+        return *this;
     }
 
     // Multiplicación de matrices (solo para 2D)
@@ -146,27 +228,58 @@ public:
         }
 
         Tensor<T, 2> result(shape_[0], other.shape_[1]);
+        matmul_into(other, result);
+        return result;
+    }
 
-        for (size_t i = 0; i < shape_[0]; ++i) {
-            for (size_t j = 0; j < other.shape_[1]; ++j) {
-                T sum = T{};
-                for (size_t k = 0; k < shape_[1]; ++k) {
-                    sum += (*this)(i, k) * other(k, j);
-                }
-                result(i, j) = sum;
-            }
+    // Igual que matmul pero escribe en result, reutilizando su memoria
+    void matmul_into(const Tensor<T, 2>& other, Tensor<T, 2>& result) const {
+        static_assert(N == 2, "Matrix multiplication is only for 2D tensors");
+
+        if (shape_[1] != other.shape_[0]) {
+            throw std::invalid_argument("Invalid dimensions for matrix multiplication");
         }
 
+        result.resize(shape_[0], other.shape_[1]);
+
+        // Kernel GEMM con paneles empaquetados (ver gemm.h)
+        gemm::gemm<T>(shape_[0], other.shape_[1], shape_[1],
+                      data_.data(), shape_[1],
+                      other.data_.data(), other.shape_[1],
+                      result.data_.data(), other.shape_[1]);
+    }
+
+    // this^T * other sin materializar la transpuesta (this: k x m, other: k x n)
+    Tensor<T, 2> matmul_tn(const Tensor<T, 2>& other) const {
+        static_assert(N == 2, "Matrix multiplication is only for 2D tensors");
+
+        if (shape_[0] != other.shape_[0]) {
+            throw std::invalid_argument("Invalid dimensions for matrix multiplication");
+        }
+
+        Tensor<T, 2> result(shape_[1], other.shape_[1]);
+        gemm::gemm<T>(gemm::Op::transpose, gemm::Op::none,
+                      shape_[1], other.shape_[1], shape_[0],
+                      data_.data(), shape_[1],
+                      other.data_.data(), other.shape_[1],
+                      result.data_.data(), other.shape_[1]);
         return result;
     }
 
-    // Aplicar función a todos los elementos
-    template<typename Func>
-    Tensor<T, N> apply(Func func) const {
-        Tensor<T, N> result = *this;
-        for (size_t i = 0; i < data_.size(); ++i) {
-            result.data_[i] = func(data_[i]);
+    // this * other^T sin materializar la transpuesta (this: m x k, other: n x k)
+    Tensor<T, 2> matmul_nt(const Tensor<T, 2>& other) const {
+        static_assert(N == 2, "Matrix multiplication is only for 2D tensors");
+
+        if (shape_[1] != other.shape_[1]) {
+            throw std::invalid_argument("Invalid dimensions for matrix multiplication");
         }
+
+        Tensor<T, 2> result(shape_[0], other.shape_[0]);
+        gemm::gemm<T>(gemm::Op::none, gemm::Op::transpose,
+                      shape_[0], other.shape_[0], shape_[1],
+                      data_.data(), shape_[1],
+                      other.data_.data(), other.shape_[1],
+                      result.data_.data(), other.shape_[0]);
         return result;
     }
 
@@ -183,20 +296,24 @@ public:
         return result;
     }
 
-    // Llenar con valores aleatorios
+    // Llenar con valores aleatorios en [min_val, max_val) (enteros: en
+    // [min_val, max_val]) con un flujo nuevo del generador global
     void random_fill(T min_val = T{}, T max_val = T{1}) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        auto rng = utec::random::next_stream();
+        random_fill(rng, min_val, max_val);
+    }
 
+    // Igual, con un generador explícito
+    template<typename Gen>
+    void random_fill(Gen& rng, T min_val, T max_val) {
         if constexpr (std::is_floating_point_v<T>) {
-            std::uniform_real_distribution<T> dis(min_val, max_val);
             for (size_t i = 0; i < data_.size(); ++i) {
-                data_[i] = dis(gen);
+                data_[i] = utec::random::uniform(rng, min_val, max_val);
             }
         } else {
-            std::uniform_int_distribution<T> dis(min_val, max_val);
+            uint64_t span = uint64_t(max_val - min_val) + 1;
             for (size_t i = 0; i < data_.size(); ++i) {
-                data_[i] = dis(gen);
+                data_[i] = T(min_val + T(utec::random::below(rng, span)));
             }
         }
     }
@@ -206,20 +323,45 @@ public:
         std::fill(data_.begin(), data_.end(), value);
     }
 
+    // Cambia la forma conservando la memoria reservada: sólo asigna si el
+    // nuevo tamaño supera la capacidad. Los valores quedan sin especificar.
+    template<typename... Args>
+        requires (sizeof...(Args) == N && (std::is_integral_v<Args> && ...))
+    void resize(Args... dimensions) {
+        shape_ = {static_cast<size_t>(dimensions)...};
+        size_t total_size = 1;
+        for (size_t dim : shape_) {
+            total_size *= dim;
+        }
+        data_.resize(total_size);
+        calculate_strides();
+    }
+
     // Acceso directo a los datos
     T* data() { return data_.data(); }
     const T* data() const { return data_.data(); }
 
+    // Vista 2D de los datos (sólo para 2D)
+    MatrixView<T> view() {
+        static_assert(N == 2, "view() is only for 2D tensors");
+        return {data_.data(), shape_[0], shape_[1]};
+    }
+
+    MatrixView<const T> view() const {
+        static_assert(N == 2, "view() is only for 2D tensors");
+        return {data_.data(), shape_[0], shape_[1]};
+    }
+
     // Imprimir tensor (para debugging)
     void print() const {
-        if (N == 1) {
+        if constexpr (N == 1) {
             std::cout << "[";
             for (size_t i = 0; i < shape_[0]; ++i) {
                 std::cout << (*this)(i);
                 if (i < shape_[0] - 1) std::cout << ", ";
             }
             std::cout << "]" << std::endl;
-        } else if (N == 2) {
+        } else if constexpr (N == 2) {
             std::cout << "[\n";
             for (size_t i = 0; i < shape_[0]; ++i) {
                 std::cout << "  [";
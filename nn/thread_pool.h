@@ -0,0 +1,129 @@
+#ifndef NN_THREAD_POOL_H
+#define NN_THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <algorithm>
+
+namespace utec {
+namespace parallel {
+
+// Pool de hilos persistente para paralelismo de datos. parallel_for reparte
+// n tareas entre los trabajadores (el hilo que llama también trabaja) y
+// bloquea hasta que terminan todas. El reparto es estático: la tarea i la
+// ejecuta siempre el hilo i % size(), así los buffers propios de cada hilo
+// (p.ej. los de empaquetado del GEMM) se reutilizan entre llamadas iguales.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+
+    const std::function<void(size_t)>* task_ = nullptr;
+    size_t task_count_ = 0;
+    size_t active_workers_ = 0;
+    size_t generation_ = 0;
+    bool stop_ = false;
+    std::exception_ptr error_;
+
+    void run_tasks(const std::function<void(size_t)>& task, size_t count, size_t first) {
+        for (size_t i = first; i < count; i += size()) {
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+        }
+    }
+
+    void worker_loop(size_t index) {
+        size_t seen_generation = 0;
+        while (true) {
+            const std::function<void(size_t)>* task;
+            size_t count;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_cv_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+                if (stop_) return;
+                seen_generation = generation_;
+                task = task_;
+                count = task_count_;
+            }
+
+            run_tasks(*task, count, index);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--active_workers_ == 0) {
+                done_cv_.notify_one();
+            }
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t num_threads = std::thread::hardware_concurrency()) {
+        // El hilo que llama a parallel_for cuenta como uno de los hilos
+        size_t extra = std::max<size_t>(num_threads, 1) - 1;
+        workers_.reserve(extra);
+        for (size_t i = 0; i < extra; ++i) {
+            workers_.emplace_back([this, i] { worker_loop(i + 1); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers_.size() + 1; }
+
+    void parallel_for(size_t count, const std::function<void(size_t)>& task) {
+        if (count == 0) return;
+        if (workers_.empty() || count == 1) {
+            for (size_t i = 0; i < count; ++i) task(i);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            task_count_ = count;
+            active_workers_ = workers_.size();
+            error_ = nullptr;
+            ++generation_;
+        }
+        start_cv_.notify_all();
+
+        run_tasks(task, count, 0);
+
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_cv_.wait(lock, [&] { return active_workers_ == 0; });
+            task_ = nullptr;
+            error = error_;
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+} // namespace parallel
+} // namespace utec
+
+#endif // NN_THREAD_POOL_H
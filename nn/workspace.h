@@ -0,0 +1,88 @@
+#ifndef NN_WORKSPACE_H
+#define NN_WORKSPACE_H
+
+// Arena de memoria para el entrenamiento: una sola reserva contiene todas
+// las matrices intermedias de un paso (entrada, activaciones de cada capa,
+// objetivos y gradientes). Primero se declaran los trozos con add(), luego
+// allocate() reserva la memoria una vez y slice() entrega vistas a cada
+// trozo. Cada trozo empieza en una dirección alineada a 64 bytes.
+
+#include "tensor.h"
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace utec {
+namespace neural_network {
+
+template<typename T>
+class Workspace {
+private:
+    struct Slot {
+        size_t offset;
+        size_t rows;
+        size_t cols;
+    };
+
+    static constexpr size_t alignment = 64;
+    static constexpr size_t align_elements = (alignment + sizeof(T) - 1) / sizeof(T);
+
+    std::vector<T> arena_;
+    std::vector<Slot> slots_;
+    size_t total_ = 0;    // elementos reservados por los trozos (con relleno)
+    T* base_ = nullptr;   // inicio alineado de arena_
+
+    static size_t round_up(size_t n) {
+        return (n + align_elements - 1) / align_elements * align_elements;
+    }
+
+public:
+    // Olvida los trozos declarados (la memoria se conserva)
+    void clear() {
+        slots_.clear();
+        total_ = 0;
+    }
+
+    // Declara un trozo de hasta rows x cols; devuelve su índice
+    size_t add(size_t rows, size_t cols) {
+        slots_.push_back({total_, rows, cols});
+        total_ += round_up(rows * cols);
+        return slots_.size() - 1;
+    }
+
+    // Reserva la memoria de todos los trozos declarados (sólo crece)
+    void allocate() {
+        size_t needed = total_ + align_elements;
+        if (arena_.size() < needed) {
+            arena_.resize(needed);
+        }
+        auto address = reinterpret_cast<std::uintptr_t>(arena_.data());
+        size_t misalignment = address % alignment;
+        base_ = arena_.data() + (misalignment ? (alignment - misalignment) / sizeof(T) : 0);
+    }
+
+    // Vista a las primeras `rows` filas del trozo id
+    utec::algebra::MatrixView<T> slice(size_t id, size_t rows) {
+        return {base_ + slots_[id].offset, rows, slots_[id].cols};
+    }
+
+    // Igual, pero con otro número de columnas (trozos compartidos entre
+    // matrices de distinto ancho; rows * cols no debe exceder lo declarado)
+    utec::algebra::MatrixView<T> slice(size_t id, size_t rows, size_t cols) {
+        return {base_ + slots_[id].offset, rows, cols};
+    }
+
+    size_t rows(size_t id) const { return slots_[id].rows; }
+    size_t bytes() const { return arena_.size() * sizeof(T); }
+
+    // Todos los trozos como un solo arreglo de size() elementos, relleno
+    // incluido (en cero salvo que se escriba en él), para recorridos lineales
+    T* data() { return base_; }
+    const T* data() const { return base_; }
+    size_t size() const { return total_; }
+};
+
+} // namespace neural_network
+} // namespace utec
+
+#endif // NN_WORKSPACE_H
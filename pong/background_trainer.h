@@ -0,0 +1,218 @@
+#ifndef PONG_BACKGROUND_TRAINER_H
+#define PONG_BACKGROUND_TRAINER_H
+
+// Entrenamiento de la política en un hilo aparte mientras se juega.
+//
+// El hilo del juego sólo hace operaciones que no bloquean ni asignan
+// memoria: record() encola la muestra de cada fotograma en una cola SPSC y
+// predict() usa la última política publicada. El hilo entrenador vacía la
+// cola en un TrainingSet, entrena una época a la vez sobre todo lo
+// acumulado y publica los pesos nuevos en un DoubleBuffer (estilo RCU).
+// Cada muestra viaja con el número de su sesión, así el entrenador sabe
+// exactamente dónde empieza una sesión nueva aunque queden muestras de la
+// anterior en la cola.
+// Cuando dejan de llegar muestras sigue hasta completar `epochs` épocas
+// más, guarda el modelo y se queda esperando datos nuevos.
+
+#include "training.h"
+#include "../nn/double_buffer.h"
+#include "../nn/profiler.h"
+#include "../nn/spsc_queue.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <stdexcept>
+#include <algorithm>
+
+namespace utec {
+namespace pong {
+
+class BackgroundTrainer {
+public:
+    struct Stats {
+        uint64_t version;        // políticas publicadas
+        uint64_t epochs;         // épocas entrenadas en total
+        uint64_t samples;        // muestras de la sesión actual
+        uint64_t saved_version;  // versión guardada en disco (0 = ninguna)
+        uint64_t checksum;       // del dataset con que se guardó
+        uint64_t dropped;        // muestras descartadas con la cola llena
+        float loss;              // de la última época
+        bool save_failed;
+    };
+
+    static constexpr size_t default_queue_capacity = size_t{1} << 16;
+
+    // Muestras mínimas antes de la primera época (un mini-batch)
+    static constexpr size_t min_samples = 256;
+
+    explicit BackgroundTrainer(std::unique_ptr<utec::neural_network::NeuralNetwork<float>> network,
+                               int epochs = TRAINING_EPOCHS * 2,
+                               size_t queue_capacity = default_queue_capacity)
+        : network_(std::move(network)), epochs_(epochs), queue_(queue_capacity) {
+        // Un núcleo queda libre para el hilo del juego
+        size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        network_->set_num_threads(std::max<size_t>(cores - 1, 1));
+        publish();
+    }
+
+    ~BackgroundTrainer() { stop(); }
+
+    BackgroundTrainer(const BackgroundTrainer&) = delete;
+    BackgroundTrainer& operator=(const BackgroundTrainer&) = delete;
+
+    // --- Hilo del juego ---
+
+    // Encola una muestra; false si la cola estaba llena y se descartó
+    // (cuenta en stats().dropped)
+    bool record(const std::array<float, 5>& state, float action) {
+        return queue_.try_push(Record{Sample{state, action}, session_});
+    }
+
+    // Salida de la última política publicada
+    float predict(const std::array<float, 5>& state) {
+        return policy_.read([&state](const PolicyNetwork& policy) { return policy.predict(state)[0]; });
+    }
+
+    // Empieza una sesión de recolección: el entrenador olvida las muestras
+    // anteriores y sigue entrenando la misma red. Arranca el hilo la
+    // primera vez.
+    void begin_session() {
+        ++session_;
+        if (!thread_.joinable()) {
+            stop_.store(false);
+            thread_ = std::thread([this] { run(); });
+        }
+    }
+
+    void stop() {
+        stop_.store(true);
+        if (thread_.joinable()) thread_.join();
+    }
+
+    bool running() const { return thread_.joinable(); }
+
+    // Archivo donde se guarda el modelo al terminar (vacío = no guardar)
+    void set_save_path(const std::string& path) {
+        require_idle();
+        save_path_ = path;
+    }
+
+    // --- Sólo con el hilo detenido ---
+
+    utec::neural_network::NeuralNetwork<float>& network() {
+        require_idle();
+        return *network_;
+    }
+
+    // Publica los pesos actuales de la red (p.ej. tras cargar un modelo)
+    void publish() {
+        require_idle();
+        policy_.write([this](PolicyNetwork& policy) { policy.assign(*network_); });
+    }
+
+    Stats stats() const {
+        return Stats{policy_.version(),
+                     epochs_done_.load(std::memory_order_relaxed),
+                     samples_.load(std::memory_order_relaxed),
+                     saved_version_.load(std::memory_order_acquire),
+                     checksum_.load(std::memory_order_relaxed),
+                     queue_.dropped(),
+                     loss_.load(std::memory_order_relaxed),
+                     save_failed_.load(std::memory_order_relaxed)};
+    }
+
+private:
+    std::unique_ptr<utec::neural_network::NeuralNetwork<float>> network_;
+    int epochs_;
+    std::string save_path_;
+
+    // Muestra de la cola con la sesión en que se grabó
+    struct Record {
+        Sample sample;
+        uint64_t session;
+    };
+
+    utec::parallel::SpscQueue<Record> queue_;
+    utec::parallel::DoubleBuffer<PolicyNetwork> policy_;
+
+    std::thread thread_;
+    std::atomic<bool> stop_{false};
+    uint64_t session_ = 0;   // sólo lo toca el hilo del juego
+
+    std::atomic<uint64_t> epochs_done_{0};
+    std::atomic<uint64_t> samples_{0};
+    std::atomic<uint64_t> saved_version_{0};
+    std::atomic<uint64_t> checksum_{0};
+    std::atomic<float> loss_{0.0f};
+    std::atomic<bool> save_failed_{false};
+
+    void require_idle() const {
+        if (thread_.joinable()) {
+            throw std::logic_error("BackgroundTrainer is running");
+        }
+    }
+
+    void run() {
+        if (utec::profiling::compiled_in) {
+            utec::profiling::Profiler::instance().set_thread_name("entrenador");
+        }
+        TrainingSet data;
+        uint64_t session = 0;
+        int epochs_left = 0;   // épocas pendientes desde la última muestra
+        bool saved = true;
+
+        while (!stop_.load(std::memory_order_relaxed)) {
+            // La primera muestra de una sesión nueva descarta las anteriores
+            size_t received = queue_.consume([&data, &session](const Record& record) {
+                if (record.session != session) {
+                    session = record.session;
+                    data.clear();
+                }
+                data.record(record.sample.state, record.sample.action);
+            });
+            if (received != 0) {
+                epochs_left = epochs_;
+                saved = false;
+                samples_.store(data.size(), std::memory_order_relaxed);
+            }
+
+            if (data.size() < min_samples || epochs_left == 0) {
+                if (!saved && epochs_left == 0) {
+                    save(data);
+                    saved = true;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
+            }
+
+            PROFILE_ZONE("Trainer::epoch");
+            float loss = network_->train(data, 1, false);
+            --epochs_left;
+            policy_.write([this](PolicyNetwork& policy) { policy.assign(*network_); });
+            loss_.store(loss, std::memory_order_relaxed);
+            PROFILE_COUNT("trainer.samples", data.size());
+            PROFILE_COUNT("trainer.loss", loss);
+            epochs_done_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void save(const TrainingSet& data) {
+        if (save_path_.empty()) return;
+        try {
+            network_->save(save_path_);
+            checksum_.store(data.checksum(), std::memory_order_relaxed);
+            save_failed_.store(false, std::memory_order_relaxed);
+            saved_version_.store(policy_.version(), std::memory_order_release);
+        } catch (const std::exception&) {
+            save_failed_.store(true, std::memory_order_relaxed);
+        }
+    }
+};
+
+} // namespace pong
+} // namespace utec
+
+#endif // PONG_BACKGROUND_TRAINER_H
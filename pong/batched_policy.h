@@ -0,0 +1,63 @@
+#ifndef PONG_BATCHED_POLICY_H
+#define PONG_BATCHED_POLICY_H
+
+// Política de la red neuronal para muchas partidas a la vez: lee las
+// observaciones de un VectorEnv como una matriz B x 5, hace una sola pasada
+// de la red (un GEMM por capa) y convierte cada salida en una dirección del
+// paddle, igual que AIPaddle::UpdateWithNN. Los buffers se reservan una vez
+// y se reutilizan en cada fotograma.
+//
+// Network es cualquier red con predict_batch(const Tensor<float, 2>&):
+// NeuralNetwork<float> o una QuantizedNetwork (int8/bf16) para evaluar
+// muchas partidas más rápido.
+
+#include "simulation.h"
+#include "vector_env.h"
+#include "../nn/network.h"
+#include <vector>
+
+namespace utec {
+namespace pong {
+
+template<typename Network = utec::neural_network::NeuralNetwork<float>>
+class BatchedPolicy {
+public:
+    explicit BatchedPolicy(Network& network,
+                           float action_threshold = 0.1f)
+        : network_(network), action_threshold_(action_threshold) {}
+
+    // Decide la dirección (-1, 0, +1) del paddle de la IA en cada partida.
+    // El puntero es válido hasta la siguiente llamada y se puede pasar
+    // directamente a VectorEnv::move_paddles.
+    const int* act(const VectorEnv& env) {
+        const size_t games = env.size();
+        states_.resize(games, 5);
+        env.observations(states_.data());
+
+        const auto& actions = network_.predict_batch(states_);
+        directions_.resize(games);
+        const float* out = actions.data();
+        const int speed = int(env.paddle_speed);
+        for (size_t g = 0; g < games; ++g) {
+            directions_[g] = policy_direction(out[g], action_threshold_, speed);
+        }
+        return directions_.data();
+    }
+
+    // Observaciones del último act() (matriz B x 5)
+    const utec::algebra::Tensor<float, 2>& states() const { return states_; }
+
+    void set_action_threshold(float threshold) { action_threshold_ = threshold; }
+    float action_threshold() const { return action_threshold_; }
+
+private:
+    Network& network_;
+    float action_threshold_;
+    utec::algebra::Tensor<float, 2> states_;
+    std::vector<int> directions_;
+};
+
+} // namespace pong
+} // namespace utec
+
+#endif // PONG_BATCHED_POLICY_H
@@ -0,0 +1,387 @@
+#ifndef PONG_DQN_H
+#define PONG_DQN_H
+
+// Aprendizaje por refuerzo estilo DQN para el AIPaddle: una red Q con tres
+// salidas (subir, quedarse, bajar) aprende de los puntos del juego (+1 si
+// anota la IA, -1 si anota el rival programado) en lugar de copiar a la
+// política programada.
+//
+// Se actúa en muchas partidas sin ventana a la vez (VectorEnv): una sola
+// pasada de la red por fotograma para todas, con exploración ε-greedy. Las
+// transiciones van a un buffer de repetición circular y se aprende con
+// mini-batches muestreados de él contra una red objetivo, copia de la red Q
+// que se actualiza cada cierto número de pasos.
+//
+// Cada acción se repite frame_skip fotogramas y cada punto cierra el
+// episodio para el bootstrap (la pelota vuelve al centro), así el horizonte
+// de un punto son unas decenas de decisiones.
+
+#include "simulation.h"
+#include "vector_env.h"
+#include "evolution.h"
+#include "../nn/network.h"
+#include "../nn/profiler.h"
+#include "../nn/random.h"
+#include <vector>
+#include <array>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+namespace utec {
+namespace pong {
+
+// Archivo de la red Q (distinta arquitectura que la política del juego)
+constexpr const char* DQN_MODEL_FILE = "pongsasos_dqn.bin";
+
+// Dirección del paddle para cada acción de la red Q
+constexpr std::array<int, 3> dqn_directions{-1, 0, 1};
+
+struct DQNConfig {
+    size_t envs = 64;                   // partidas en paralelo
+    size_t replay_capacity = 500000;    // transiciones (24 MB)
+    size_t batch_size = 64;
+    size_t warmup = 5000;               // transiciones antes de aprender
+    size_t updates_per_step = 4;        // mini-batches por paso de las partidas
+    size_t target_update = 2000;        // mini-batches entre copias a la red objetivo
+    int frame_skip = 4;
+    float gamma = 0.99f;
+    float learning_rate = 0.00025f;
+    float epsilon_start = 1.0f;
+    float epsilon_end = 0.05f;
+    size_t epsilon_decay = 200000;      // transiciones hasta epsilon_end
+    uint64_t seed = Rng::default_seed;
+};
+
+// Transición de tamaño fijo (48 bytes, sin memoria dinámica)
+struct Transition {
+    std::array<float, 5> state;
+    std::array<float, 5> next_state;
+    float reward;
+    uint8_t action;
+    bool done;      // hubo un punto: no se hace bootstrap desde next_state
+};
+
+// Buffer de repetición circular: las transiciones nuevas reemplazan a las
+// más antiguas y se muestrean uniformemente
+class ReplayBuffer {
+public:
+    explicit ReplayBuffer(size_t capacity) : transitions_(capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Replay buffer capacity must be positive");
+        }
+    }
+
+    void push(const Transition& transition) {
+        transitions_[next_] = transition;
+        next_ = (next_ + 1) % transitions_.size();
+        size_ = std::min(size_ + 1, transitions_.size());
+    }
+
+    template<typename Gen>
+    const Transition& sample(Gen& rng) const {
+        return transitions_[utec::random::below(rng, size_)];
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return transitions_.size(); }
+
+private:
+    std::vector<Transition> transitions_;
+    size_t next_ = 0;
+    size_t size_ = 0;
+};
+
+struct DQNStats {
+    size_t steps = 0;               // pasos de las partidas (cada uno envs transiciones)
+    size_t transitions = 0;
+    size_t updates = 0;             // mini-batches aprendidos
+    int matches = 0;                // partidas terminadas (con exploración)
+    int wins = 0;
+    float loss = 0.0f;              // media de los mini-batches
+    float epsilon = 0.0f;           // al final
+    double seconds = 0.0;
+
+    float win_rate() const { return matches > 0 ? float(wins) / matches : 0.0f; }
+    double transitions_per_second() const { return seconds > 0 ? transitions / seconds : 0.0; }
+};
+
+class DQNTrainer {
+public:
+    // Red Q: 5 -> 32 -> 32 -> 3 con tanh en las capas ocultas y salida lineal
+    static std::unique_ptr<utec::neural_network::NeuralNetwork<float>> make_q_network() {
+        auto network = std::make_unique<utec::neural_network::NeuralNetwork<float>>();
+        network->add_dense_layer(5, 32);
+        network->add_activation("tanh");
+        network->add_dense_layer(32, 32);
+        network->add_activation("tanh");
+        network->add_dense_layer(32, 3);
+        network->set_loss_function("mse");
+        return network;
+    }
+
+    // Red con las mismas capas que `network` (pesos aún sin copiar): la red
+    // objetivo de una red Q cargada, que puede no ser la de make_q_network
+    static std::unique_ptr<utec::neural_network::NeuralNetwork<float>> same_architecture(
+            const utec::neural_network::NeuralNetwork<float>& network) {
+        auto copy = std::make_unique<utec::neural_network::NeuralNetwork<float>>();
+        for (const auto& layer : network.layers()) {
+            std::string type = layer->type();
+            if (type == "dense") {
+                auto shape = layer->parameter_shapes()[0];
+                copy->add_dense_layer(shape[0], shape[1]);
+            } else if (type.rfind("activation_", 0) == 0) {
+                copy->add_activation(type.substr(11));
+            } else {
+                throw std::invalid_argument("Cannot copy layer for the DQN target network: " + type);
+            }
+        }
+        return copy;
+    }
+
+    explicit DQNTrainer(DQNConfig config = {})
+        : DQNTrainer(make_q_network(), config) {}
+
+    // Parte de una red Q dada (p.ej. una cargada con load)
+    DQNTrainer(std::unique_ptr<utec::neural_network::NeuralNetwork<float>> network, DQNConfig config)
+        : config_(config), online_(std::move(network)), target_(same_architecture(*online_)),
+          replay_(config.replay_capacity), env_(config.envs, config.seed), rng_(utec::random::make_stream(config.seed, 0)),
+          previous_(config.envs), player_directions_(config.envs), ai_directions_(config.envs),
+          actions_(config.envs), rewards_(config.envs), done_(config.envs) {
+        if (config_.envs == 0 || config_.batch_size == 0 || config_.frame_skip <= 0) {
+            throw std::invalid_argument("DQN needs environments, a batch size and frame_skip > 0");
+        }
+        // Un mini-batch completo por llamada a train: no hace falta barajar
+        online_->set_optimizer("adam", config_.learning_rate);
+        online_->set_batch_size(0, false);
+        target_->set_parameters(online_->get_parameters());
+        states_.resize(config_.envs, 5);
+        env_.observations(states_.data());
+        batch_states_.resize(config_.batch_size, 5);
+        batch_next_.resize(config_.batch_size, 5);
+        batch_targets_.resize(config_.batch_size, 3);
+    }
+
+    // Avanza las partidas `steps` pasos (cada uno frame_skip fotogramas en
+    // todas), guardando las transiciones y aprendiendo de mini-batches
+    DQNStats run(size_t steps) {
+        PROFILE_ZONE("DQNTrainer::run");
+        auto start = std::chrono::steady_clock::now();
+        DQNStats stats;
+        double loss_sum = 0.0;
+        const size_t envs = env_.size();
+
+        for (size_t s = 0; s < steps; ++s) {
+            // ε-greedy sobre una pasada de la red para todas las partidas
+            const float epsilon = this->epsilon();
+            const auto& q = online_->predict_batch(states_);
+            for (size_t g = 0; g < envs; ++g) {
+                actions_[g] = utec::random::uniform01<float>(rng_) < epsilon ? uint8_t(utec::random::below(rng_, 3)) : greedy(q.data() + 3 * g);
+                ai_directions_[g] = dqn_directions[actions_[g]];
+            }
+
+            play_frames(rewards_.data(), done_.data());
+
+            // Las recompensas ya están leídas: se reinician las terminadas.
+            // La partida pudo terminar en cualquiera de los frame_skip
+            // fotogramas, así que no basta con VectorEnv::reset_finished.
+            for (size_t g = 0; g < envs; ++g) {
+                if (env_.over(g)) {
+                    stats.matches++;
+                    stats.wins += env_.ai_score[g] >= points_to_win ? 1 : 0;
+                    env_.reset(g);
+                }
+            }
+
+            next_states_.resize(envs, 5);
+            env_.observations(next_states_.data());
+            for (size_t g = 0; g < envs; ++g) {
+                Transition t;
+                std::copy_n(states_.data() + 5 * g, 5, t.state.begin());
+                std::copy_n(next_states_.data() + 5 * g, 5, t.next_state.begin());
+                t.reward = rewards_[g];
+                t.action = actions_[g];
+                t.done = done_[g] != 0;
+                replay_.push(t);
+            }
+            std::swap(states_, next_states_);
+            transitions_ += envs;
+            stats.transitions += envs;
+            stats.steps++;
+
+            if (replay_.size() >= std::max(config_.warmup, config_.batch_size)) {
+                for (size_t u = 0; u < config_.updates_per_step; ++u) {
+                    loss_sum += learn();
+                    stats.updates++;
+                }
+            }
+        }
+
+        stats.loss = stats.updates > 0 ? float(loss_sum / stats.updates) : 0.0f;
+        stats.epsilon = epsilon();
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+
+    // Juega `matches` partidas nuevas contra el rival programado, todas en
+    // un VectorEnv, con ε = epsilon_end. Como en la evaluación de DQN, una
+    // exploración mínima evita que la política greedy (determinista, igual
+    // que el rival) quede atrapada en un peloteo que se repite.
+    MatchStats evaluate(size_t matches, uint64_t seed, int max_frames = 10000) {
+        return evaluate(matches, seed, max_frames, config_.epsilon_end);
+    }
+
+    MatchStats evaluate(size_t matches, uint64_t seed, int max_frames, float epsilon) {
+        VectorEnv env(matches, seed);
+        auto rng = utec::random::make_stream(seed, 1);
+        utec::algebra::Tensor<float, 2> states(matches, 5);
+        std::vector<int> player(matches), ai(matches);
+        std::vector<uint8_t> finished(matches, 0);
+        MatchStats stats;
+        for (int frame = 0; frame < max_frames && stats.matches < int(matches); ++frame) {
+            if (frame % config_.frame_skip == 0) {
+                env.observations(states.data());
+                const auto& q = online_->predict_batch(states);
+                for (size_t g = 0; g < matches; ++g) {
+                    uint8_t action = utec::random::uniform01<float>(rng) < epsilon ? uint8_t(utec::random::below(rng, 3)) : greedy(q.data() + 3 * g);
+                    ai[g] = dqn_directions[action];
+                }
+            }
+            scripted_directions(env, player.data());
+            env.step(player.data(), ai.data());
+            for (size_t g = 0; g < matches; ++g) {
+                if (!finished[g] && env.over(g)) {
+                    finished[g] = 1;
+                    stats.matches++;
+                    stats.wins += env.ai_score[g] >= points_to_win ? 1 : 0;
+                    stats.points_won += env.ai_score[g];
+                    stats.points_lost += env.player_score[g];
+                }
+            }
+        }
+        // Partidas que llegaron al límite de fotogramas: cuentan sin ganar
+        for (size_t g = 0; g < matches; ++g) {
+            if (!finished[g]) {
+                stats.matches++;
+                stats.points_won += env.ai_score[g];
+                stats.points_lost += env.player_score[g];
+            }
+        }
+        return stats;
+    }
+
+    // ε actual: decae linealmente con las transiciones vistas
+    float epsilon() const {
+        float progress = std::min(1.0f, float(transitions_) / float(std::max<size_t>(config_.epsilon_decay, 1)));
+        return std::lerp(config_.epsilon_start, config_.epsilon_end, progress);
+    }
+
+    utec::neural_network::NeuralNetwork<float>& network() { return *online_; }
+    const ReplayBuffer& replay() const { return replay_; }
+    const DQNConfig& config() const { return config_; }
+    size_t transitions() const { return transitions_; }
+    size_t updates() const { return updates_; }
+
+private:
+    using Tensor2 = utec::algebra::Tensor<float, 2>;
+
+    DQNConfig config_;
+    std::unique_ptr<utec::neural_network::NeuralNetwork<float>> online_;
+    std::unique_ptr<utec::neural_network::NeuralNetwork<float>> target_;
+    ReplayBuffer replay_;
+    VectorEnv env_;
+    SplitMix64 rng_;
+    size_t transitions_ = 0;
+    size_t updates_ = 0;
+
+    // Buffers reutilizados entre pasos y mini-batches
+    std::vector<Score> previous_;
+    std::vector<int> player_directions_;
+    std::vector<int> ai_directions_;
+    std::vector<uint8_t> actions_;
+    std::vector<float> rewards_;
+    std::vector<uint8_t> done_;
+    Tensor2 states_, next_states_;
+    Tensor2 batch_states_, batch_next_, batch_targets_;
+    std::vector<const Transition*> batch_;
+    std::vector<uint8_t> next_actions_;
+
+    static uint8_t greedy(const float* q) {
+        return uint8_t(std::max_element(q, q + 3) - q);
+    }
+
+    // El rival programado de cada partida (scripted_direction sobre el
+    // VectorEnv), decidido con la pelota del fotograma anterior
+    static void scripted_directions(const VectorEnv& env, int* out) {
+        for (size_t g = 0; g < env.size(); ++g) {
+            float diff_y = env.ball_y[g] - env.paddle_height / 2 - env.player_y[g];
+            out[g] = std::abs(diff_y) > 10.0f ? (diff_y > 0 ? 1 : -1) : 0;
+        }
+    }
+
+    // frame_skip fotogramas con las acciones de ai_directions_; suma los
+    // puntos de cada partida y marca las que tuvieron alguno
+    void play_frames(float* rewards, uint8_t* done) {
+        const size_t envs = env_.size();
+        for (size_t g = 0; g < envs; ++g) {
+            previous_[g] = Score{env_.player_score[g], env_.ai_score[g]};
+        }
+        for (int f = 0; f < config_.frame_skip; ++f) {
+            scripted_directions(env_, player_directions_.data());
+            env_.step(player_directions_.data(), ai_directions_.data());
+        }
+        for (size_t g = 0; g < envs; ++g) {
+            int won = env_.ai_score[g] - previous_[g].ai;
+            int lost = env_.player_score[g] - previous_[g].player;
+            rewards[g] = float(won - lost);
+            done[g] = (won | lost) != 0;
+        }
+    }
+
+    // Un mini-batch del buffer. El objetivo de la acción tomada es
+    // r + γ Q_objetivo(s', argmax_a Q(s', a)) (Double DQN: la red Q elige y
+    // la objetivo evalúa, lo que evita sobreestimar); las demás acciones
+    // tienen como objetivo su propia predicción, así la pérdida MSE sólo
+    // empuja la salida de la acción tomada.
+    float learn() {
+        PROFILE_ZONE("DQNTrainer::learn");
+        const size_t batch = config_.batch_size;
+        batch_.resize(batch);
+        next_actions_.resize(batch);
+        for (size_t i = 0; i < batch; ++i) {
+            batch_[i] = &replay_.sample(rng_);
+            std::copy_n(batch_[i]->state.begin(), 5, batch_states_.data() + 5 * i);
+            std::copy_n(batch_[i]->next_state.begin(), 5, batch_next_.data() + 5 * i);
+        }
+
+        const auto& next_online = online_->predict_batch(batch_next_);
+        for (size_t i = 0; i < batch; ++i) {
+            next_actions_[i] = greedy(next_online.data() + 3 * i);
+        }
+        const auto& next_q = target_->predict_batch(batch_next_);
+        for (size_t i = 0; i < batch; ++i) {
+            batch_targets_(i, 0) = batch_[i]->reward +
+                (batch_[i]->done ? 0.0f : config_.gamma * next_q(i, next_actions_[i]));
+        }
+        const auto& q = online_->predict_batch(batch_states_);
+        for (size_t i = 0; i < batch; ++i) {
+            float target = batch_targets_(i, 0);
+            for (size_t a = 0; a < 3; ++a) {
+                batch_targets_(i, a) = a == batch_[i]->action ? target : q(i, a);
+            }
+        }
+
+        float loss = online_->train(batch_states_, batch_targets_, 1, false);
+        if (++updates_ % config_.target_update == 0) {
+            target_->set_parameters(online_->get_parameters());
+        }
+        return loss;
+    }
+};
+
+} // namespace pong
+} // namespace utec
+
+#endif // PONG_DQN_H
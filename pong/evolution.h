@@ -0,0 +1,268 @@
+#ifndef PONG_EVOLUTION_H
+#define PONG_EVOLUTION_H
+
+// Estrategias evolutivas (ES) para la política del AIPaddle. En lugar de
+// imitar a la política programada, cada generación perturba el vector plano
+// de pesos de la red con ruido gaussiano en pares antitéticos (θ + σε y
+// θ - σε), juega cada perturbación contra el rival programado y mueve θ en
+// la dirección de las que ganaron más.
+//
+// Los rollouts se reparten entre todos los núcleos. Cada hilo regenera el
+// ruido de su par a partir de una semilla derivada de (generación, par), así
+// que entre hilos sólo viajan índices y retornos escalares; el hilo principal
+// vuelve a generar el mismo ruido para el gradiente. Por eso el resultado no
+// depende del número de hilos.
+
+#include "simulation.h"
+#include "training.h"
+#include "self_play.h"
+#include "../nn/network.h"
+#include "../nn/optimizer.h"
+#include "../nn/thread_pool.h"
+#include "../nn/profiler.h"
+#include "../nn/random.h"
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <numeric>
+#include <algorithm>
+
+namespace utec {
+namespace pong {
+
+struct EvolutionConfig {
+    size_t pairs = 32;              // perturbaciones antitéticas por generación
+    int matches = 2;                // partidas por rollout
+    float sigma = 0.1f;             // desviación del ruido
+    float learning_rate = 0.05f;    // Adam sobre el gradiente estimado
+    float hit_bonus = 0.05f;        // recompensa por devolver la pelota
+    int max_frames = 10000;         // límite por partida (peloteos sin fin)
+    float action_threshold = 0.1f;  // igual que el AIPaddle
+    size_t num_threads = 0;         // 0 = todos los núcleos
+    uint32_t seed = Rng::default_seed;
+};
+
+// Resultado de partidas de la política contra el rival programado
+struct MatchStats {
+    int matches = 0;
+    int wins = 0;
+    int points_won = 0;
+    int points_lost = 0;
+    int hits = 0;                   // devoluciones del paddle de la IA
+
+    float win_rate() const { return matches > 0 ? float(wins) / matches : 0.0f; }
+
+    // Retorno de ES: diferencia de puntos más un bono por devolución, por partida
+    float reward(float hit_bonus) const {
+        if (matches == 0) return 0.0f;
+        return (points_won - points_lost + hit_bonus * hits) / matches;
+    }
+
+    void add(const MatchStats& other) {
+        matches += other.matches;
+        wins += other.wins;
+        points_won += other.points_won;
+        points_lost += other.points_lost;
+        hits += other.hits;
+    }
+};
+
+// Una partida del AIPaddle controlado por `policy` (predict de un estado)
+// contra el jugador movido por la política programada. El rival decide con
+// la pelota del fotograma anterior, como un humano que ve la pantalla.
+template<typename Policy>
+MatchStats play_against_scripted(const Policy& policy, uint32_t seed, int max_frames,
+                                 float action_threshold = 0.1f) {
+    Game game(seed);
+    game.reset();
+    MatchStats stats;
+    for (int frame = 0; frame < max_frames && !game.over(); ++frame) {
+        int player_direction = scripted_direction(game.player, game.ball);
+        int speed_x = game.ball.speed_x;
+        Score before = game.score;
+        game.step(player_direction, [&](Paddle& ai, const Ball& ball) {
+            float action = policy.predict(ball.normalized_state(ai.y))[0];
+            ai.move(policy_direction(action, action_threshold, ai.speed));
+        });
+        // La pelota venía hacia la IA y vuelve sin que haya punto: devolución
+        if (speed_x < 0 && game.ball.speed_x > 0 &&
+            game.score.ai == before.ai && game.score.player == before.player) {
+            stats.hits++;
+        }
+    }
+    stats.matches = 1;
+    stats.wins = game.score.ai >= points_to_win ? 1 : 0;
+    stats.points_won = game.score.ai;
+    stats.points_lost = game.score.player;
+    return stats;
+}
+
+struct EvolutionStats {
+    int generation = 0;
+    size_t rollouts = 0;
+    float mean_reward = 0.0f;       // de la población
+    float best_reward = 0.0f;
+    float win_rate = 0.0f;          // partidas ganadas por la población
+    double seconds = 0.0;           // de esta generación
+
+    double generations_per_second() const { return seconds > 0 ? 1.0 / seconds : 0.0; }
+};
+
+class EvolutionStrategies {
+public:
+    // Parte de los pesos actuales de la red, que debe tener la arquitectura
+    // de PolicyNetwork; step() le escribe los pesos nuevos
+    explicit EvolutionStrategies(utec::neural_network::NeuralNetwork<float>& network,
+                                 EvolutionConfig config = {})
+        : network_(network), config_(config), theta_(network.get_parameters()),
+          optimizer_(utec::neural_network::make_optimizer<float>("adam", config.learning_rate)) {
+        PolicyNetwork{}.assign(network);  // valida la arquitectura
+        if (config_.pairs == 0 || config_.matches <= 0) {
+            throw std::invalid_argument("Evolution strategies need at least one pair and one match");
+        }
+        size_t threads = config_.num_threads;
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        pool_ = std::make_unique<utec::parallel::ThreadPool>(std::min(threads, config_.pairs));
+        workers_.resize(pool_->size());
+        for (auto& worker : workers_) {
+            worker.noise.resize(theta_.size());
+            worker.parameters.resize(theta_.size());
+        }
+        results_.resize(2 * config_.pairs);
+        rewards_.resize(2 * config_.pairs);
+        utility_.resize(2 * config_.pairs);
+        noise_.resize(theta_.size());
+        gradient_.resize(theta_.size());
+    }
+
+    // Una generación: 2 * pairs rollouts en paralelo y un paso de Adam
+    EvolutionStats step() {
+        PROFILE_ZONE("EvolutionStrategies::step");
+        auto start = std::chrono::steady_clock::now();
+        const int generation = generation_;
+
+        // Sólo el índice del par entra al hilo y sólo retornos salen de él.
+        // El reparto de parallel_for es estático (par i -> hilo i % size),
+        // así que cada hilo usa siempre el mismo Worker.
+        pool_->parallel_for(config_.pairs, [&](size_t pair) {
+            Worker& worker = workers_[pair % workers_.size()];
+            uint64_t key = pair_seed(generation, pair);
+            sample_noise(key, worker.noise.data(), worker.noise.size());
+            for (int sign = 0; sign < 2; ++sign) {
+                float scale = sign == 0 ? config_.sigma : -config_.sigma;
+                for (size_t i = 0; i < theta_.size(); ++i) {
+                    worker.parameters[i] = theta_[i] + scale * worker.noise[i];
+                }
+                worker.policy.assign(worker.parameters.data());
+                // Ambos lados del par juegan las mismas partidas
+                MatchStats stats;
+                for (int m = 0; m < config_.matches; ++m) {
+                    stats.add(play_against_scripted(worker.policy, match_seed(uint32_t(key), m),
+                                                    config_.max_frames, config_.action_threshold));
+                }
+                results_[2 * pair + sign] = stats;
+            }
+        });
+
+        // Rangos centrados en [-0.5, 0.5]: el paso no depende de la escala
+        // de los retornos y un rollout atípico no domina. Los empates
+        // comparten el rango medio, así no aportan gradiente.
+        const size_t n = results_.size();
+        for (size_t i = 0; i < n; ++i) rewards_[i] = results_[i].reward(config_.hit_bonus);
+        order_.resize(n);
+        std::iota(order_.begin(), order_.end(), size_t{0});
+        std::sort(order_.begin(), order_.end(), [&](size_t a, size_t b) { return rewards_[a] < rewards_[b]; });
+        for (size_t first = 0; first < n;) {
+            size_t last = first;
+            while (last + 1 < n && rewards_[order_[last + 1]] == rewards_[order_[first]]) ++last;
+            float rank = 0.5f * float(first + last);
+            for (size_t r = first; r <= last; ++r) {
+                utility_[order_[r]] = n > 1 ? rank / float(n - 1) - 0.5f : 0.0f;
+            }
+            first = last + 1;
+        }
+
+        // g = 1/(pairs·σ) Σ (u⁺ - u⁻) ε; el optimizador minimiza, así que -g
+        std::fill(gradient_.begin(), gradient_.end(), 0.0f);
+        for (size_t pair = 0; pair < config_.pairs; ++pair) {
+            sample_noise(pair_seed(generation, pair), noise_.data(), noise_.size());
+            float weight = -(utility_[2 * pair] - utility_[2 * pair + 1]) / (config_.pairs * config_.sigma);
+            for (size_t i = 0; i < gradient_.size(); ++i) {
+                gradient_[i] += weight * noise_[i];
+            }
+        }
+        optimizer_->step(theta_.data(), gradient_.data(), theta_.size());
+        network_.set_parameters(theta_);
+
+        MatchStats population;
+        for (const auto& result : results_) population.add(result);
+
+        EvolutionStats stats;
+        stats.generation = ++generation_;
+        stats.rollouts = n;
+        stats.mean_reward = population.reward(config_.hit_bonus);
+        stats.best_reward = rewards_[order_.back()];
+        stats.win_rate = population.win_rate();
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+
+    // Juega `matches` partidas con los pesos actuales, sin ruido, en paralelo
+    MatchStats evaluate(int matches, uint32_t seed) {
+        PolicyNetwork policy;
+        policy.assign(theta_.data());
+        std::vector<MatchStats> results(std::max(matches, 0));
+        pool_->parallel_for(results.size(), [&](size_t m) {
+            results[m] = play_against_scripted(policy, match_seed(seed, m),
+                                               config_.max_frames, config_.action_threshold);
+        });
+        MatchStats total;
+        for (const auto& result : results) total.add(result);
+        return total;
+    }
+
+    const std::vector<float>& parameters() const { return theta_; }
+    const EvolutionConfig& config() const { return config_; }
+    int generation() const { return generation_; }
+    size_t num_threads() const { return pool_->size(); }
+
+private:
+    // Lo que cada hilo reutiliza entre pares y generaciones
+    struct alignas(64) Worker {
+        std::vector<float> noise;
+        std::vector<float> parameters;
+        PolicyNetwork policy;
+    };
+
+    utec::neural_network::NeuralNetwork<float>& network_;
+    EvolutionConfig config_;
+    std::vector<float> theta_;
+    std::unique_ptr<utec::neural_network::Optimizer<float>> optimizer_;
+    std::unique_ptr<utec::parallel::ThreadPool> pool_;
+    std::vector<Worker> workers_;
+    std::vector<MatchStats> results_;   // [2·par] = +σε, [2·par + 1] = -σε
+    std::vector<float> rewards_;
+    std::vector<float> utility_;
+    std::vector<size_t> order_;
+    std::vector<float> noise_;
+    std::vector<float> gradient_;
+    int generation_ = 0;
+
+    // Un flujo por (generación, par)
+    uint64_t pair_seed(int generation, size_t pair) const {
+        return utec::random::stream_seed(config_.seed, uint64_t(generation) * config_.pairs + pair);
+    }
+
+    // ε ~ N(0, 1) reproducible a partir de la semilla del par
+    static void sample_noise(uint64_t seed, float* out, size_t n) {
+        SplitMix64 rng(seed);
+        for (size_t i = 0; i < n; ++i) out[i] = utec::random::normal<float>(rng);
+    }
+};
+
+} // namespace pong
+} // namespace utec
+
+#endif // PONG_EVOLUTION_H
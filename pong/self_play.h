@@ -0,0 +1,89 @@
+#ifndef PONG_SELF_PLAY_H
+#define PONG_SELF_PLAY_H
+
+// Generación de datos en paralelo: muchas partidas independientes repartidas
+// entre hilos. Cada partida tiene su propia semilla derivada de la semilla
+// base y de su índice, y cada hilo escribe en su propio buffer, que se une a
+// los demás al final sin necesidad de locks.
+
+#include "simulation.h"
+#include "training.h"
+#include "../nn/thread_pool.h"
+#include <vector>
+#include <chrono>
+#include <thread>
+
+namespace utec {
+namespace pong {
+
+// Semilla independiente para la partida `index` (mezcla SplitMix64)
+inline uint32_t match_seed(uint32_t seed, uint64_t index) {
+    SplitMix64 mix((uint64_t(seed) << 32) + index);
+    return static_cast<uint32_t>(mix());
+}
+
+// Una partida de entrenamiento completa (hasta points_to_win)
+inline void play_training_match(uint32_t seed, TrainingSet& data) {
+    Game game(seed);
+    game.reset();
+    while (!game.over()) {
+        game.step(0, [&data](Paddle& ai, const Ball& ball) {
+            record_scripted_move(ai, ball, data);
+        });
+    }
+}
+
+struct SelfPlayStats {
+    int matches = 0;
+    size_t threads = 0;
+    size_t samples = 0;
+    double seconds = 0.0;
+
+    double games_per_second() const { return seconds > 0 ? matches / seconds : 0.0; }
+};
+
+// Juega `matches` partidas en `num_threads` hilos (0 = todos los núcleos).
+// Las partidas se reparten en bloques contiguos y los buffers se concatenan
+// en orden, así el dataset no depende del número de hilos.
+inline SelfPlayStats run_self_play(uint32_t seed, int matches, size_t num_threads, TrainingSet& out) {
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    num_threads = std::min<size_t>(num_threads, std::max(matches, 1));
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Alineados a línea de caché para que los hilos no compartan cabeceras
+    struct alignas(64) WorkerBuffer {
+        TrainingSet data;
+    };
+    std::vector<WorkerBuffer> buffers(num_threads);
+
+    utec::parallel::ThreadPool pool(num_threads);
+    pool.parallel_for(num_threads, [&](size_t w) {
+        size_t begin = size_t(matches) * w / num_threads;
+        size_t end = size_t(matches) * (w + 1) / num_threads;
+        for (size_t m = begin; m < end; ++m) {
+            play_training_match(match_seed(seed, m), buffers[w].data);
+        }
+    });
+
+    // Unir los buffers de cada hilo
+    size_t added = 0;
+    for (const auto& buffer : buffers) {
+        added += buffer.data.size();
+        out.append(buffer.data);
+    }
+
+    SelfPlayStats stats;
+    stats.matches = matches;
+    stats.threads = num_threads;
+    stats.samples = added;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+} // namespace pong
+} // namespace utec
+
+#endif // PONG_SELF_PLAY_H
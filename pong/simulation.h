@@ -0,0 +1,220 @@
+#ifndef PONG_SIMULATION_H
+#define PONG_SIMULATION_H
+
+// Lógica del juego Pong sin dependencias de raylib: física de la pelota,
+// paddles, colisiones y puntaje. La usan tanto la ventana (main.cpp) como las
+// herramientas sin ventana, así ambos modos simulan exactamente lo mismo.
+
+#include "../nn/profiler.h"
+#include "../nn/random.h"
+#include <array>
+#include <cmath>
+#include <random>
+#include <cstdint>
+#include <algorithm>
+
+namespace utec {
+namespace pong {
+
+constexpr int screen_width = 1200;
+constexpr int screen_height = 800;
+constexpr int points_to_win = 5;
+
+// Generador de cada partida. La secuencia de std::mt19937 está fijada por
+// el estándar y el saque sólo usa rng() % 2, así que las partidas con la
+// misma semilla son iguales con cualquier compilador.
+using Rng = std::mt19937;
+
+// Flujos baratos de 8 bytes (ver nn/random.h), p.ej. uno por partida en
+// VectorEnv. Sirven en cualquier función de este archivo que reciba un
+// generador.
+using SplitMix64 = utec::random::SplitMix64;
+
+struct Score {
+    int player = 0;
+    int ai = 0;
+};
+
+struct Ball {
+    float x = screen_width / 2;
+    float y = screen_height / 2;
+    int speed_x = 7;
+    int speed_y = 7;
+    int radius = 20;
+
+    // Estado normalizado que recibe la red neuronal
+    std::array<float, 5> normalized_state(float paddle_y) const {
+        return {
+            x / float(screen_width),            // Posición X normalizada
+            y / float(screen_height),           // Posición Y normalizada
+            speed_x / 10.0f,                    // Velocidad X normalizada
+            speed_y / 10.0f,                    // Velocidad Y normalizada
+            paddle_y / float(screen_height)     // Posición paddle normalizada
+        };
+    }
+};
+
+struct Paddle {
+    float x = 0;
+    float y = screen_height / 2 - 60;
+    float width = 25;
+    float height = 120;
+    int speed = 6;
+
+    // direction: -1 sube, +1 baja, 0 se queda quieto
+    void move(int direction) {
+        y += direction * speed;
+    }
+
+    void limit_movement() {
+        if (y <= 0) {
+            y = 0;
+        }
+        if (y + height >= screen_height) {
+            y = screen_height - height;
+        }
+    }
+};
+
+// Misma prueba que CheckCollisionCircleRec de raylib
+inline bool check_collision_circle_rec(float cx, float cy, float radius, const Paddle& rec) {
+    float half_w = rec.width / 2.0f;
+    float half_h = rec.height / 2.0f;
+    float dx = std::fabs(cx - (rec.x + half_w));
+    float dy = std::fabs(cy - (rec.y + half_h));
+
+    if (dx > (half_w + radius)) return false;
+    if (dy > (half_h + radius)) return false;
+    if (dx <= half_w) return true;
+    if (dy <= half_h) return true;
+
+    float corner_dx = dx - half_w;
+    float corner_dy = dy - half_h;
+    return (corner_dx * corner_dx + corner_dy * corner_dy) <= (radius * radius);
+}
+
+// Vuelve la pelota al centro con una dirección aleatoria
+template<typename Gen>
+void reset_ball(Ball& ball, Gen& rng) {
+    ball.x = screen_width / 2;
+    ball.y = screen_height / 2;
+    const int speed_choices[2] = {-1, 1};
+    ball.speed_x *= speed_choices[rng() % 2];
+    ball.speed_y *= speed_choices[rng() % 2];
+}
+
+// Mueve la pelota, rebota en los bordes y anota puntos
+template<typename Gen>
+void update_ball(Ball& ball, Score& score, Gen& rng) {
+    PROFILE_ZONE("Ball::Update");
+    ball.x += ball.speed_x;
+    ball.y += ball.speed_y;
+
+    if (ball.y + ball.radius >= screen_height || ball.y - ball.radius <= 0) {
+        ball.speed_y *= -1;
+    }
+
+    if (ball.x + ball.radius >= screen_width) {
+        score.ai++;
+        reset_ball(ball, rng);
+    }
+    if (ball.x - ball.radius <= 0) {
+        score.player++;
+        reset_ball(ball, rng);
+    }
+}
+
+inline void bounce_on_paddle(Ball& ball, const Paddle& paddle) {
+    if (check_collision_circle_rec(ball.x, ball.y, ball.radius, paddle)) {
+        ball.speed_x *= -1;
+    }
+}
+
+// Movimiento (-1, 0, +1) de la política programada: perseguir la pelota
+inline int scripted_direction(const Paddle& paddle, const Ball& ball) {
+    float diff_y = ball.y - paddle.height / 2 - paddle.y;
+    if (std::abs(diff_y) > 10.0f) {  // Umbral para evitar micro-movimientos
+        return diff_y > 0 ? 1 : -1;
+    }
+    return 0;
+}
+
+// Política programada que genera los datos de entrenamiento: persigue la
+// pelota y devuelve la acción objetivo normalizada en [-1, 1].
+inline float scripted_policy(Paddle& paddle, const Ball& ball) {
+    // Calcular donde debería estar el paddle
+    float target_y = ball.y - paddle.height / 2;
+    float diff_y = target_y - paddle.y;
+
+    float target_action = 0.0f;
+    if (std::abs(diff_y) > 5.0f) {  // Solo moverse si la diferencia es significativa
+        target_action = std::max(-1.0f, std::min(1.0f, diff_y / (float)paddle.speed));
+    }
+
+    paddle.move(scripted_direction(paddle, ball));
+    return target_action;
+}
+
+// Convierte la salida de la red en un movimiento discreto del paddle
+inline int policy_direction(float action, float action_threshold, int speed) {
+    if (std::abs(action) > action_threshold) {
+        // Escalar la acción de manera más agresiva
+        float movement = action * speed * 1.5f;
+        if (movement > 2.0f) return 1;
+        if (movement < -2.0f) return -1;
+    }
+    return 0;
+}
+
+// Un fotograma completo: pelota, jugador, IA y colisiones. ai_controller
+// recibe (Paddle& ai, const Ball& ball) y mueve el paddle de la IA después de
+// que la pelota se haya movido, igual que en el bucle de la ventana.
+template<typename Gen, typename AiController>
+void step(Ball& ball, Paddle& player, Paddle& ai, Score& score, Gen& rng,
+          int player_direction, AiController&& ai_controller) {
+    update_ball(ball, score, rng);
+
+    player.move(player_direction);
+    player.limit_movement();
+
+    ai_controller(ai, ball);
+    ai.limit_movement();
+
+    bounce_on_paddle(ball, player);
+    bounce_on_paddle(ball, ai);
+}
+
+// Estado completo de una partida, para simular sin ventana
+struct Game {
+    Ball ball;
+    Paddle player;
+    Paddle ai;
+    Score score;
+    Rng rng;
+
+    explicit Game(uint32_t seed = Rng::default_seed) : rng(seed) {
+        player.x = screen_width - player.width - 10;
+        ai.x = 10;
+    }
+
+    void reset() {
+        reset_ball(ball, rng);
+        player.y = screen_height / 2 - player.height / 2;
+        ai.y = screen_height / 2 - ai.height / 2;
+        score = Score{};
+    }
+
+    bool over() const {
+        return score.ai >= points_to_win || score.player >= points_to_win;
+    }
+
+    template<typename AiController>
+    void step(int player_direction, AiController&& ai_controller) {
+        pong::step(ball, player, ai, score, rng, player_direction, ai_controller);
+    }
+};
+
+} // namespace pong
+} // namespace utec
+
+#endif // PONG_SIMULATION_H
@@ -0,0 +1,107 @@
+#ifndef PONG_TRAINING_H
+#define PONG_TRAINING_H
+
+// Recolección de datos y entrenamiento de la política del AIPaddle,
+// compartidos por el juego con ventana y por la herramienta pong_train.
+
+#include "simulation.h"
+#include "../nn/network.h"
+#include "../nn/static_network.h"
+#include <vector>
+#include <array>
+#include <memory>
+#include <iostream>
+
+namespace utec {
+namespace pong {
+
+// Configuración de la red neuronal
+constexpr int TRAINING_GAMES = 100;
+constexpr int TRAINING_EPOCHS = 50;
+
+// Archivo del modelo entrenado, compartido por el juego y pong_train
+constexpr const char* MODEL_FILE = "pongsasos_model.bin";
+
+// Registro de tamaño fijo de un fotograma (24 bytes, sin memoria
+// dinámica): lo que viaja del juego al entrenador en segundo plano
+struct Sample {
+    std::array<float, 5> state;
+    float action;
+};
+
+static_assert(sizeof(Sample) == 6 * sizeof(float), "Sample must stay a packed 24-byte record");
+
+// Muestras (estado normalizado, acción objetivo) de la política programada,
+// en trozos de 4096 fotogramas (ver nn/dataset.h). checksum() da lo mismo
+// que cuando los estados y las acciones vivían en dos vectores.
+struct TrainingSet : utec::neural_network::ChunkedDataset<float> {
+    TrainingSet() : ChunkedDataset<float>(5, 1) {}
+
+    void record(const std::array<float, 5>& state, float action) {
+        append(state.data(), &action);
+    }
+};
+
+// Un paso de la política programada que además guarda la muestra en data
+// (un TrainingSet o cualquier otro destino con record(state, action))
+template<typename Samples>
+void record_scripted_move(Paddle& paddle, const Ball& ball, Samples& data) {
+    auto state = ball.normalized_state(paddle.y);
+    float target_action = scripted_policy(paddle, ball);
+    data.record(state, target_action);
+}
+
+// Juega `games` partidas de entrenamiento sin ventana, con la misma
+// secuencia de fotogramas que el modo entrenamiento de main.cpp.
+inline void collect_training_games(uint32_t seed, int games, TrainingSet& data) {
+    Game game(seed);
+    game.reset();
+    int games_played = 0;
+    while (games_played < games) {
+        game.step(0, [&data](Paddle& ai, const Ball& ball) {
+            record_scripted_move(ai, ball, data);
+        });
+        if (game.over()) {
+            games_played++;
+            game.reset();
+        }
+    }
+}
+
+// Arquitectura de la política, fija en tiempo de compilación para jugar
+// (los pesos se copian de la red dinámica entrenada o del archivo)
+using PolicyNetwork = utec::neural_network::StaticNetwork<float, 5, 16, 16, 1>;
+
+// Arquitectura: 5 inputs -> 16 hidden -> 16 hidden -> 1 output
+inline std::unique_ptr<utec::neural_network::NeuralNetwork<float>> make_policy_network() {
+    auto network = std::make_unique<utec::neural_network::NeuralNetwork<float>>();
+
+    network->add_dense_layer(5, 16);
+    network->add_activation("tanh");
+    network->add_dense_layer(16, 16);
+    network->add_activation("tanh");
+    network->add_dense_layer(16, 1);
+    network->add_activation("tanh");
+
+    // Adam llega en ~25 épocas a la pérdida que sgd (lr 0.05) alcanza en
+    // 100 (ver bench_optimizers)
+    network->set_optimizer("adam", 0.001f);
+    network->set_loss_function("mse");
+
+    // Mini-batches barajados, gradientes calculados con todos los núcleos
+    network->set_batch_size(256);
+    network->set_num_threads(0);
+
+    return network;
+}
+
+// Entrena directamente sobre los trozos del dataset, sin copiarlo
+inline void train_policy(utec::neural_network::NeuralNetwork<float>& network, const TrainingSet& data,
+                         int epochs, bool verbose = true) {
+    network.train(data, epochs, verbose);
+}
+
+} // namespace pong
+} // namespace utec
+
+#endif // PONG_TRAINING_H
@@ -0,0 +1,216 @@
+#ifndef PONG_VECTOR_ENV_H
+#define PONG_VECTOR_ENV_H
+
+// Entorno vectorizado: K partidas de Pong guardadas como arreglos
+// contiguos (struct-of-arrays) y avanzadas juntas. Los bucles sobre las
+// partidas no tienen ramas (las condiciones se escriben como selecciones),
+// por lo que el compilador los vectoriza; sólo los puntos anotados, que son
+// raros, se resuelven partida por partida.
+//
+// Cada fotograma reproduce pong::step fotograma a fotograma: primero se
+// mueven las pelotas (advance_balls), luego se leen las observaciones y se
+// deciden las acciones, y por último se mueven los paddles y se resuelven
+// las colisiones (move_paddles).
+
+#include "simulation.h"
+#include <vector>
+#include <cstdint>
+#include <cmath>
+
+namespace utec {
+namespace pong {
+
+class VectorEnv {
+public:
+    // Estado de cada partida (índice = partida)
+    std::vector<float> ball_x, ball_y;
+    std::vector<float> ball_vx, ball_vy;
+    std::vector<float> player_y, ai_y;
+    std::vector<int> player_score, ai_score;
+    std::vector<SplitMix64> rng;
+
+    // Geometría común a todas las partidas (valores por defecto de Ball/Paddle)
+    const float radius = Ball{}.radius;
+    const float paddle_width = Paddle{}.width;
+    const float paddle_height = Paddle{}.height;
+    const float paddle_speed = Paddle{}.speed;
+    const float player_x = screen_width - Paddle{}.width - 10;
+    const float ai_x = 10;
+
+    explicit VectorEnv(size_t num_games, uint64_t seed = 0)
+        : ball_x(num_games), ball_y(num_games), ball_vx(num_games), ball_vy(num_games),
+          player_y(num_games), ai_y(num_games), player_score(num_games), ai_score(num_games),
+          scored_(num_games), still_(num_games, 0) {
+        rng.reserve(num_games);
+        for (size_t g = 0; g < num_games; ++g) {
+            rng.push_back(utec::random::make_stream(seed, g));
+        }
+        for (size_t g = 0; g < num_games; ++g) {
+            Ball ball;
+            ball_vx[g] = ball.speed_x;
+            ball_vy[g] = ball.speed_y;
+            reset(g);
+        }
+    }
+
+    size_t size() const { return ball_x.size(); }
+
+    // Equivalente a Game::reset para la partida g
+    void reset(size_t g) {
+        serve(g);
+        player_y[g] = screen_height / 2 - paddle_height / 2;
+        ai_y[g] = screen_height / 2 - paddle_height / 2;
+        player_score[g] = 0;
+        ai_score[g] = 0;
+    }
+
+    bool over(size_t g) const {
+        return ai_score[g] >= points_to_win || player_score[g] >= points_to_win;
+    }
+
+    // Reinicia las partidas terminadas; devuelve cuántas había. Sólo puede
+    // terminar una partida en la que hubo un punto en este fotograma.
+    size_t reset_finished() {
+        if (!any_scored_) return 0;
+        size_t finished = 0;
+        for (size_t g = 0; g < size(); ++g) {
+            if (over(g)) {
+                reset(g);
+                ++finished;
+            }
+        }
+        return finished;
+    }
+
+    // Primera mitad del fotograma: mueve las pelotas, rebota en los bordes y
+    // anota los puntos (equivalente a update_ball).
+    void advance_balls() {
+        const size_t n = size();
+        float* x = ball_x.data();
+        float* y = ball_y.data();
+        float* vx = ball_vx.data();
+        float* vy = ball_vy.data();
+        uint8_t* scored = scored_.data();
+        const float r = radius;
+        const float w = screen_width;
+        const float h = screen_height;
+
+        uint8_t any = 0;
+        for (size_t g = 0; g < n; ++g) {
+            float nx = x[g] + vx[g];
+            float ny = y[g] + vy[g];
+            bool wall = (ny + r >= h) | (ny - r <= 0.0f);
+            vy[g] = wall ? -vy[g] : vy[g];
+            x[g] = nx;
+            y[g] = ny;
+            // 1 = punto de la IA (sale por la derecha), 2 = punto del jugador
+            uint8_t event = uint8_t(nx + r >= w) | uint8_t(uint8_t(nx - r <= 0.0f) << 1);
+            scored[g] = event;
+            any |= event;
+        }
+
+        any_scored_ = any != 0;
+        if (any) {
+            for (size_t g = 0; g < n; ++g) {
+                if (scored[g] & 1) {
+                    ai_score[g]++;
+                    serve(g);
+                }
+                // Tras el saque la pelota está en el centro: no puede anotar dos veces
+                if ((scored[g] & 2) && x[g] - r <= 0.0f) {
+                    player_score[g]++;
+                    serve(g);
+                }
+            }
+        }
+    }
+
+    // Observaciones normalizadas para el paddle de la IA: matriz K x 5 con el
+    // mismo orden que Ball::normalized_state.
+    void observations(float* out) const {
+        for (size_t g = 0; g < size(); ++g) {
+            float* o = out + g * 5;
+            o[0] = ball_x[g] / float(screen_width);
+            o[1] = ball_y[g] / float(screen_height);
+            o[2] = ball_vx[g] / 10.0f;
+            o[3] = ball_vy[g] / 10.0f;
+            o[4] = ai_y[g] / float(screen_height);
+        }
+    }
+
+    // Segunda mitad del fotograma: mueve los paddles (-1, 0, +1 por partida;
+    // nullptr = no se mueven), los limita a la pantalla y resuelve las
+    // colisiones con la pelota.
+    void move_paddles(const int* player_direction, const int* ai_direction) {
+        const size_t n = size();
+        float* py = player_y.data();
+        float* ay = ai_y.data();
+        const float* x = ball_x.data();
+        const float* y = ball_y.data();
+        float* vx = ball_vx.data();
+        const float h = screen_height;
+        const float ph = paddle_height;
+        const int speed = int(paddle_speed);
+        const int* pd = player_direction ? player_direction : still_.data();
+        const int* ad = ai_direction ? ai_direction : still_.data();
+        const float r = radius;
+        const float half_w = paddle_width / 2.0f;
+        const float half_h = paddle_height / 2.0f;
+        const float px = player_x;
+        const float ax = ai_x;
+
+        for (size_t g = 0; g < n; ++g) {
+            float p = py[g] + float(pd[g] * speed);
+            p = (p <= 0.0f) ? 0.0f : p;
+            p = (p + ph >= h) ? h - ph : p;
+            py[g] = p;
+
+            float a = ay[g] + float(ad[g] * speed);
+            a = (a <= 0.0f) ? 0.0f : a;
+            a = (a + ph >= h) ? h - ph : a;
+            ay[g] = a;
+
+            // Jugador y luego IA, como en pong::step
+            float v = vx[g];
+            v = collides(x[g], y[g], r, px, p, half_w, half_h) ? -v : v;
+            v = collides(x[g], y[g], r, ax, a, half_w, half_h) ? -v : v;
+            vx[g] = v;
+        }
+    }
+
+    // Fotograma completo con acciones decididas de antemano
+    void step(const int* player_direction, const int* ai_direction) {
+        advance_balls();
+        move_paddles(player_direction, ai_direction);
+    }
+
+private:
+    std::vector<uint8_t> scored_;
+    bool any_scored_ = true;
+    std::vector<int> still_;        // direcciones nulas para paddles sin acción
+
+    // Vuelve la pelota al centro con dirección aleatoria (como reset_ball)
+    void serve(size_t g) {
+        ball_x[g] = screen_width / 2;
+        ball_y[g] = screen_height / 2;
+        ball_vx[g] *= (rng[g]() % 2) ? 1.0f : -1.0f;
+        ball_vy[g] *= (rng[g]() % 2) ? 1.0f : -1.0f;
+    }
+
+    // check_collision_circle_rec sin ramas
+    static bool collides(float cx, float cy, float r, float px, float py, float half_w, float half_h) {
+        float dx = std::fabs(cx - (px + half_w));
+        float dy = std::fabs(cy - (py + half_h));
+        float corner_dx = dx - half_w;
+        float corner_dy = dy - half_h;
+        bool near = (dx <= half_w + r) & (dy <= half_h + r);
+        bool inside = (dx <= half_w) | (dy <= half_h) |
+                      (corner_dx * corner_dx + corner_dy * corner_dy <= r * r);
+        return near & inside;
+    }
+};
+
+} // namespace pong
+} // namespace utec
+
+#endif // PONG_VECTOR_ENV_H
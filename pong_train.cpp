@@ -0,0 +1,221 @@
+//
+// Entrenamiento sin ventana: simula las partidas de entrenamiento tan rápido
+// como permita la CPU y entrena la red del AIPaddle con esos datos.
+//
+// Uso: pong_train [--seed N] [--games N] [--epochs N] [--threads N]
+//                  [--load ARCHIVO] [--save ARCHIVO] [--dataset ARCHIVO]
+//                  [--es GENERACIONES] [--dqn PASOS]
+//
+// Con --threads (0 = todos los núcleos) las partidas se juegan como partidas
+// independientes en paralelo; sin la opción se recolectan en secuencia, igual
+// que el modo entrenamiento de la ventana.
+//
+// El modelo entrenado se guarda en --save (por defecto el mismo archivo que
+// carga el juego al iniciar). Con --load se parte de un modelo guardado en
+// lugar de pesos aleatorios.
+//
+// Con --dataset las muestras se agregan a un dataset en disco (creado si no
+// existe) y se entrena con todo lo acumulado por las ejecuciones anteriores;
+// en memoria sólo queda un trozo de 4096 fotogramas.
+//
+// Con --es no se imita a la política programada: la red (aleatoria o la de
+// --load) se mejora con estrategias evolutivas jugando contra ella durante
+// GENERACIONES generaciones, con rollouts en --threads hilos (por defecto
+// todos los núcleos).
+//
+// Con --dqn se entrena por refuerzo una red Q (subir/quedarse/bajar) con
+// los puntos de PASOS pasos de 64 partidas en paralelo, y se guarda la
+// versión que mejor le gana al rival programado en DQN_MODEL_FILE (o en
+// --save). --load continúa desde una red Q guardada.
+//
+
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <cstring>
+#include "pong/training.h"
+#include "pong/self_play.h"
+#include "pong/evolution.h"
+#include "pong/dqn.h"
+
+using namespace std;
+namespace pong = utec::pong;
+
+// Estrategias evolutivas contra el rival programado; reporta generaciones/s
+// y la tasa de victorias de la población y de la red sin ruido
+static int run_evolution(uint32_t seed, int generations, size_t threads,
+                         const string& load_path, const string& save_path) {
+    auto network = pong::make_policy_network();
+    if (!load_path.empty()) {
+        network->load(load_path);
+        cout << "Modelo cargado desde " << load_path << endl;
+    }
+
+    pong::EvolutionConfig config;
+    config.seed = seed;
+    config.num_threads = threads;
+    pong::EvolutionStrategies es(*network, config);
+    cout << "Estrategias evolutivas: " << 2 * config.pairs << " rollouts de " << config.matches
+         << " partidas por generación en " << es.num_threads() << " hilos" << endl;
+
+    double seconds = 0.0;   // sólo las generaciones, sin las evaluaciones
+    for (int g = 0; g < generations; ++g) {
+        auto stats = es.step();
+        seconds += stats.seconds;
+        if (stats.generation % 10 == 0 || stats.generation == generations) {
+            auto eval = es.evaluate(100, seed ^ 0x5EEDu);
+            cout << "Generación " << stats.generation
+                 << ": " << stats.generation / seconds << " gen/s"
+                 << ", retorno medio " << stats.mean_reward
+                 << ", victorias población " << 100.0f * stats.win_rate << "%"
+                 << ", red " << 100.0f * eval.win_rate() << "% ("
+                 << eval.points_won << "-" << eval.points_lost << ")" << endl;
+        }
+    }
+
+    network->save(save_path);
+    cout << "Modelo guardado en " << save_path << endl;
+    return 0;
+}
+
+// DQN contra el rival programado; cada 500 pasos reporta transiciones/s y
+// la tasa de victorias (con exploración y evaluada en 64 partidas nuevas)
+static int run_dqn(uint32_t seed, size_t steps, const string& load_path, const string& save_path) {
+    auto network = pong::DQNTrainer::make_q_network();
+    if (!load_path.empty()) {
+        network->load(load_path);
+        cout << "Red Q cargada desde " << load_path << endl;
+    }
+
+    pong::DQNConfig config;
+    config.seed = seed;
+    pong::DQNTrainer dqn(std::move(network), config);
+    cout << "DQN: " << config.envs << " partidas en paralelo, buffer de " << config.replay_capacity
+         << " transiciones" << endl;
+
+    const size_t chunk = 500;
+    double seconds = 0.0;
+    float best = 0.0f;      // sólo se guarda una red que gane alguna partida
+    for (size_t done = 0; done < steps; done += chunk) {
+        auto stats = dqn.run(std::min(chunk, steps - done));
+        seconds += stats.seconds;
+        auto eval = dqn.evaluate(64, seed + done);
+        cout << "Transiciones " << dqn.transitions()
+             << ": " << dqn.transitions() / seconds << "/s"
+             << ", ε " << stats.epsilon << ", pérdida " << stats.loss
+             << ", victorias entrenando " << 100.0f * stats.win_rate() << "%"
+             << ", evaluación " << 100.0f * eval.win_rate() << "% ("
+             << eval.points_won << "-" << eval.points_lost << ")" << endl;
+        if (eval.win_rate() > best) {
+            best = eval.win_rate();
+            dqn.network().save(save_path);
+        }
+    }
+    cout << "Entrenamiento: " << seconds << " s";
+    if (best > 0.0f) {
+        cout << "; mejor red (" << 100.0f * best << "% de victorias) guardada en " << save_path << endl;
+    } else {
+        // Con pocas transiciones (menos de unos 3M) la red aún no gana
+        cout << endl << "Advertencia: ninguna evaluación ganó partidas; no se guardó la red"
+             << " (" << save_path << " no se modificó). Pruebe con más pasos." << endl;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t seed = pong::Rng::default_seed;
+    int games = pong::TRAINING_GAMES;
+    int epochs = pong::TRAINING_EPOCHS * 2;
+    bool parallel = false;
+    size_t threads = 1;
+    string load_path;
+    string save_path;   // por defecto el archivo del modo elegido
+    string dataset_path;
+    int es_generations = 0;
+    size_t dqn_steps = 0;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--seed") == 0) {
+            seed = static_cast<uint32_t>(stoul(argv[i + 1]));
+        } else if (strcmp(argv[i], "--games") == 0) {
+            games = stoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--epochs") == 0) {
+            epochs = stoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            parallel = true;
+            threads = stoul(argv[i + 1]);
+        } else if (strcmp(argv[i], "--load") == 0) {
+            load_path = argv[i + 1];
+        } else if (strcmp(argv[i], "--save") == 0) {
+            save_path = argv[i + 1];
+        } else if (strcmp(argv[i], "--dataset") == 0) {
+            dataset_path = argv[i + 1];
+        } else if (strcmp(argv[i], "--es") == 0) {
+            es_generations = stoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--dqn") == 0) {
+            dqn_steps = stoul(argv[i + 1]);
+        } else {
+            cerr << "Opción desconocida: " << argv[i] << endl;
+            return 1;
+        }
+    }
+
+    using clock = chrono::steady_clock;
+
+    // Pesos iniciales y barajado salen del generador global: con la misma
+    // semilla y los mismos hilos el entrenamiento se repite bit a bit
+    utec::random::seed(seed);
+
+    if (dqn_steps > 0) {
+        return run_dqn(seed, dqn_steps, load_path, save_path.empty() ? pong::DQN_MODEL_FILE : save_path);
+    }
+    if (save_path.empty()) {
+        save_path = pong::MODEL_FILE;
+    }
+    if (es_generations > 0) {
+        return run_evolution(seed, es_generations, parallel ? threads : 0, load_path, save_path);
+    }
+
+    cout << "Simulando " << games << " partidas (semilla " << seed << ")..." << endl;
+    pong::TrainingSet data;
+    if (!dataset_path.empty()) {
+        data.spill_to(dataset_path);
+        cout << "Dataset " << dataset_path << ": " << data.size() << " muestras previas" << endl;
+    }
+    size_t previous = data.size();
+    auto start = clock::now();
+    if (parallel) {
+        auto stats = pong::run_self_play(seed, games, threads, data);
+        cout << "Partidas independientes en " << stats.threads << " hilos" << endl;
+    } else {
+        pong::collect_training_games(seed, games, data);
+    }
+    double sim_seconds = chrono::duration<double>(clock::now() - start).count();
+
+    data.flush();
+    size_t collected = data.size() - previous;
+
+    cout << "Muestras: " << data.size()
+         << ", checksum: " << hex << data.checksum() << dec << endl;
+    cout << "Simulación: " << sim_seconds << " s ("
+         << games / sim_seconds << " partidas/s, "
+         << collected / sim_seconds << " fotogramas/s)" << endl;
+
+    auto network = pong::make_policy_network();
+    if (!load_path.empty()) {
+        start = clock::now();
+        network->load(load_path);
+        double load_ms = chrono::duration<double, milli>(clock::now() - start).count();
+        cout << "Modelo cargado desde " << load_path << " en " << load_ms << " ms" << endl;
+    }
+
+    start = clock::now();
+    pong::train_policy(*network, data, epochs, true);
+    double train_seconds = chrono::duration<double>(clock::now() - start).count();
+    cout << "Entrenamiento: " << train_seconds << " s (" << epochs << " épocas)" << endl;
+
+    network->save(save_path);
+    cout << "Modelo guardado en " << save_path << endl;
+
+    return 0;
+}
@@ -5,13 +5,45 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <numeric>
+#include <algorithm>
 #include "nn/tensor.h"
 #include "nn/network.h"
+#include "nn/dataset.h"
+#include "nn/static_network.h"
+#include "nn/quantized.h"
+#include "nn/spsc_queue.h"
+#include "nn/double_buffer.h"
+#include "nn/profiler.h"
+#include "nn/random.h"
 
 using namespace std;
 using namespace utec::algebra;
 using namespace utec::neural_network;
 
+// Contador de asignaciones de memoria (para la prueba del workspace)
+static std::atomic<size_t> allocation_count{0};
+
+// malloc/free van detrás de funciones no inline para que GCC no empareje
+// un free con la memoria de operator new (-Wmismatched-new-delete)
+[[gnu::noinline]] static void* counted_allocate(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] static void counted_release(void* p) noexcept { std::free(p); }
+
+void* operator new(size_t size) { return counted_allocate(size); }
+void operator delete(void* p) noexcept { counted_release(p); }
+void operator delete(void* p, size_t) noexcept { counted_release(p); }
+
 // Función de prueba para verificar que los valores son aproximadamente iguales
 bool approx_equal(double a, double b, double epsilon = 1e-6) {
     return abs(a - b) < epsilon;
@@ -73,9 +105,92 @@ void test_tensor_operations() {
     assert(At(2, 1) == 6);
     cout << "✓ Transpose funciona correctamente" << endl;
 
+    // Test 6: Acceso variádico para cualquier rango y at() con comprobación
+    Tensor<int, 3> t5(2, 3, 4);
+    t5(1, 2, 3) = 42;
+    assert(t5.strides()[0] == 12 && t5.strides()[1] == 4 && t5.strides()[2] == 1);
+    assert(t5.data()[1 * 12 + 2 * 4 + 3] == 42);
+    assert(t5.at(1, 2, 3) == 42);
+
+    bool thrown = false;
+    try {
+        t5.at(2, 0, 0);
+    } catch (const out_of_range&) {
+        thrown = true;
+    }
+    assert(thrown);
+    cout << "✓ Acceso variádico y at() funcionan correctamente" << endl;
+
+    // Test 7: Expresiones perezosas y asignaciones compuestas
+    Tensor<float, 2> a(37, 29), b(37, 29), c(37, 29), r(37, 29);
+    a.random_fill(-1.0f, 1.0f);
+    b.random_fill(-1.0f, 1.0f);
+    c.random_fill(-1.0f, 1.0f);
+    size_t before = allocation_count.load();
+    r = a + b * 0.5f - c;
+    r += a;
+    r -= 2.0f * c;
+    r *= 3.0f;
+    r = r + a.apply([](float x) { return x * x; });
+    size_t allocations = allocation_count.load() - before;
+    for (size_t i = 0; i < r.size(); ++i) {
+        float expected = 3.0f * (a[i] + b[i] * 0.5f - c[i] + a[i] - 2.0f * c[i]) + a[i] * a[i];
+        assert(approx_equal(r[i], expected, 1e-5f));
+    }
+    assert(allocations == 0);
+
+    auto lazy = (a - b) * 2.0f;
+    assert(approx_equal(lazy(3, 4), 2.0f * (a(3, 4) - b(3, 4)), 1e-6f));
+    Tensor<float, 2> evaluated = lazy.eval();
+    assert(evaluated.shape() == a.shape() && evaluated(36, 28) == lazy(36, 28));
+
+    thrown = false;
+    try {
+        r += t1;
+    } catch (const invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    cout << "✓ Expresiones en un recorrido; +=, -=, *= sin asignar memoria" << endl;
+
     cout << "¡Todas las pruebas de Tensor pasaron!" << endl << endl;
 }
 
+void test_gemm_kernels() {
+    cout << "=== Probando kernels GEMM ===" << endl;
+
+    // Formas con bordes parciales en todas las dimensiones y k > KC
+    const size_t shapes[][3] = {{1, 5, 16}, {7, 16, 16}, {33, 16, 1}, {100, 300, 37}, {13, 5, 50}};
+
+    for (gemm::Isa isa : {gemm::Isa::scalar, gemm::Isa::avx2, gemm::Isa::avx512}) {
+        gemm::force_isa(isa);
+        for (const auto& s : shapes) {
+            size_t m = s[0], k = s[1], n = s[2];
+            Tensor<float, 2> A(m, k), B(k, n);
+            A.random_fill(-1.0f, 1.0f);
+            B.random_fill(-1.0f, 1.0f);
+
+            auto C = A.matmul(B);
+            // Variantes transpuestas: A^T se pasa como k x m y B^T como n x k
+            auto Ctn = A.transpose().matmul_tn(B);
+            auto Cnt = A.matmul_nt(B.transpose());
+            for (size_t i = 0; i < m; ++i) {
+                for (size_t j = 0; j < n; ++j) {
+                    double expected = 0.0;
+                    for (size_t p = 0; p < k; ++p) expected += double(A(i, p)) * B(p, j);
+                    assert(approx_equal(C(i, j), expected, 1e-3));
+                    assert(approx_equal(Ctn(i, j), expected, 1e-3));
+                    assert(approx_equal(Cnt(i, j), expected, 1e-3));
+                }
+            }
+        }
+        cout << "✓ GEMM " << gemm::isa_name(gemm::active_isa()) << " coincide con la referencia" << endl;
+    }
+    gemm::force_isa(gemm::detected_isa());
+
+    cout << "¡Todas las pruebas de GEMM pasaron!" << endl << endl;
+}
+
 void test_activation_functions() {
     cout << "=== Probando funciones de activación ===" << endl;
 
@@ -108,6 +223,62 @@ void test_activation_functions() {
     cout << "¡Todas las pruebas de funciones de activación pasaron!" << endl << endl;
 }
 
+void test_activation_kernels() {
+    cout << "=== Probando kernels de activación ===" << endl;
+
+    // 1037 elementos: incluye un resto que no llena un registro
+    const size_t n = 1037;
+    vector<float> x(n), g(n), y(n), grad(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = -12.0f + 24.0f * float(i) / float(n - 1);
+        g[i] = std::cos(float(i));
+    }
+
+    for (gemm::Isa isa : {gemm::Isa::scalar, gemm::Isa::avx2, gemm::Isa::avx512}) {
+        gemm::force_isa(isa);
+
+        Tanh<float>::forward(x.data(), y.data(), n);
+        Tanh<float>::backward(g.data(), y.data(), grad.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            assert(approx_equal(y[i], std::tanh(x[i]), 1e-6f));
+            assert(approx_equal(grad[i], g[i] * Tanh<float>::backward(x[i]), 1e-6f));
+        }
+
+        Sigmoid<float>::forward(x.data(), y.data(), n);
+        Sigmoid<float>::backward(g.data(), y.data(), grad.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            assert(approx_equal(y[i], Sigmoid<float>::forward(x[i]), 1e-6f));
+            assert(approx_equal(grad[i], g[i] * Sigmoid<float>::backward(x[i]), 1e-6f));
+        }
+
+        ReLU<float>::forward(x.data(), y.data(), n);
+        ReLU<float>::backward(g.data(), y.data(), grad.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            assert(y[i] == ReLU<float>::forward(x[i]));
+            assert(grad[i] == g[i] * ReLU<float>::backward(x[i]));
+        }
+
+        // En el mismo arreglo (las capas de activación trabajan in-place)
+        y = x;
+        Tanh<float>::forward(y.data(), y.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            assert(approx_equal(y[i], std::tanh(x[i]), 1e-6f));
+        }
+        cout << "✓ Activaciones " << gemm::isa_name(gemm::active_isa()) << " coinciden con std" << endl;
+    }
+    gemm::force_isa(gemm::detected_isa());
+
+    try {
+        NeuralNetwork<float> net;
+        net.add_activation("swish");
+        assert(false);
+    } catch (const invalid_argument&) {
+        cout << "✓ Activación desconocida rechazada" << endl;
+    }
+
+    cout << "¡Todas las pruebas de kernels de activación pasaron!" << endl << endl;
+}
+
 void test_neural_network() {
     cout << "=== Probando red neuronal ===" << endl;
 
@@ -164,6 +335,916 @@ void test_neural_network() {
     cout << "¡Todas las pruebas de red neuronal pasaron!" << endl << endl;
 }
 
+void test_minibatch_training() {
+    cout << "=== Probando entrenamiento por mini-batches en paralelo ===" << endl;
+
+    // Regresión simple: y = 0.5 * (x0 - x1)
+    const size_t samples = 2048;
+    Tensor<float, 2> X(samples, 2);
+    Tensor<float, 2> y(samples, 1);
+    X.random_fill(-1.0f, 1.0f);
+    for (size_t i = 0; i < samples; i++) {
+        y(i, 0) = 0.5f * (X(i, 0) - X(i, 1));
+    }
+
+    NeuralNetwork<float> nn;
+    nn.add_dense_layer(2, 8);
+    nn.add_activation("tanh");
+    nn.add_dense_layer(8, 1);
+    nn.set_optimizer("sgd", 0.05f);
+    nn.set_loss_function("mse");
+    nn.set_batch_size(128);
+    nn.set_num_threads(4);
+    assert(nn.num_threads() == 4);
+
+    nn.train(X, y, 20, false);
+
+    auto pred = nn.predict(X);
+    double mse = 0.0;
+    for (size_t i = 0; i < samples; i++) {
+        double diff = pred(i, 0) - y(i, 0);
+        mse += diff * diff;
+    }
+    mse /= samples;
+    cout << "MSE después de 20 épocas: " << mse << endl;
+    assert(mse < 0.01);
+    cout << "✓ Mini-batches barajados con 4 hilos convergen" << endl;
+
+    cout << "¡Todas las pruebas de mini-batches pasaron!" << endl << endl;
+}
+
+void test_optimizers() {
+    cout << "=== Probando optimizadores ===" << endl;
+
+    // Cinco pasos con los mismos gradientes en cada ISA; 1037 parámetros
+    // incluyen un resto que no llena un registro
+    const size_t n = 1037;
+    for (const char* name : {"sgd", "momentum", "rmsprop", "adam"}) {
+        vector<vector<float>> results;
+        for (gemm::Isa isa : {gemm::Isa::scalar, gemm::Isa::avx2, gemm::Isa::avx512}) {
+            gemm::force_isa(isa);
+            vector<float> params(n), grads(n);
+            for (size_t i = 0; i < n; ++i) params[i] = std::sin(float(i));
+
+            auto optimizer = make_optimizer<float>(name, 0.01f);
+            for (int step = 0; step < 5; ++step) {
+                for (size_t i = 0; i < n; ++i) grads[i] = std::cos(float(i * 7 + step));
+                optimizer->step(params.data(), grads.data(), n);
+            }
+            assert(optimizer->steps() == 5);
+            results.push_back(params);
+        }
+        for (const auto& result : results) {
+            for (size_t i = 0; i < n; ++i) {
+                assert(approx_equal(result[i], results[0][i], 1e-5f));
+            }
+        }
+    }
+    gemm::force_isa(gemm::detected_isa());
+    cout << "✓ Actualizaciones AVX2/AVX-512 coinciden con el recorrido escalar" << endl;
+
+    // Todos convergen en la regresión de test_minibatch_training
+    const size_t samples = 1024;
+    Tensor<float, 2> X(samples, 2);
+    Tensor<float, 2> y(samples, 1);
+    X.random_fill(-1.0f, 1.0f);
+    for (size_t i = 0; i < samples; i++) {
+        y(i, 0) = 0.5f * (X(i, 0) - X(i, 1));
+    }
+    for (auto [name, lr] : {pair{"sgd", 0.05f}, pair{"momentum", 0.02f}, pair{"rmsprop", 0.005f}, pair{"adam", 0.01f}}) {
+        NeuralNetwork<float> nn;
+        nn.add_dense_layer(2, 8);
+        nn.add_activation("tanh");
+        nn.add_dense_layer(8, 1);
+        nn.set_optimizer(name, lr);
+        nn.set_batch_size(64);
+        assert(nn.optimizer().name() == name);
+
+        float loss = nn.train(X, y, 20, false);
+        cout << name << ": pérdida " << loss << " tras 20 épocas" << endl;
+        assert(loss < 0.01f);
+    }
+    cout << "✓ sgd, momentum, rmsprop y adam convergen" << endl;
+
+    try {
+        NeuralNetwork<float> net;
+        net.set_optimizer("adagrad", 0.01f);
+        assert(false);
+    } catch (const invalid_argument&) {
+        cout << "✓ Optimizador desconocido rechazado" << endl;
+    }
+
+    cout << "¡Todas las pruebas de optimizadores pasaron!" << endl << endl;
+}
+
+void test_parameter_buffer() {
+    cout << "=== Probando buffer contiguo de parámetros ===" << endl;
+
+    const size_t samples = 1000;
+    Tensor<float, 2> X(samples, 5);
+    Tensor<float, 2> y(samples, 1);
+    X.random_fill(-1.0f, 1.0f);
+    y.random_fill(-1.0f, 1.0f);
+
+    const string path = "test_parameter_buffer.bin";
+    float norms[2];
+    for (size_t threads : {1, 4}) {
+        NeuralNetwork<float> nn;
+        nn.add_dense_layer(5, 16);
+        nn.add_activation("tanh");
+        nn.add_dense_layer(16, 1);
+        if (threads == 1) {
+            nn.save(path);
+        } else {
+            nn.load(path);
+        }
+        nn.set_optimizer("sgd", 0.0f);
+        nn.set_num_threads(threads);
+        nn.train(X, y, 1, false);
+        assert(nn.parameter_count() == 5 * 16 + 16 + 16 + 1);
+
+        // Pesos y biases de todas las capas seguidos en un mismo buffer,
+        // cada tensor alineado a 64 bytes
+        vector<const float*> blobs;
+        for (const auto& layer : nn.layers()) {
+            for (const auto& view : layer->parameters()) {
+                assert(reinterpret_cast<uintptr_t>(view.data) % 64 == 0);
+                blobs.push_back(view.data);
+            }
+        }
+        assert(blobs.size() == 4);
+        for (size_t b = 1; b < blobs.size(); ++b) {
+            assert(blobs[b] > blobs[b - 1] && blobs[b] - blobs[0] < 512);
+        }
+
+        // La norma sobre el buffer coincide con la de cada gradiente
+        double sum = 0.0;
+        for (const auto& layer : nn.layers()) {
+            for (const auto& view : layer->gradients()) {
+                for (size_t i = 0; i < view.size(); ++i) sum += double(view.data[i]) * view.data[i];
+            }
+        }
+        norms[threads == 1 ? 0 : 1] = nn.gradient_norm();
+        assert(nn.gradient_norm() > 0.0f);
+        assert(approx_equal(nn.gradient_norm(), float(std::sqrt(sum)), 1e-5f));
+    }
+    remove(path.c_str());
+    assert(approx_equal(norms[0], norms[1], 1e-4f));
+    cout << "✓ Los gradientes reducidos de 4 hilos coinciden con los de 1 hilo" << endl;
+
+    cout << "¡Todas las pruebas del buffer de parámetros pasaron!" << endl << endl;
+}
+
+void test_chunked_dataset() {
+    cout << "=== Probando dataset por trozos ===" << endl;
+
+    const size_t samples = 1000;
+    Tensor<float, 2> X(samples, 5);
+    Tensor<float, 2> y(samples, 1);
+    X.random_fill(-1.0f, 1.0f);
+    y.random_fill(-1.0f, 1.0f);
+
+    ChunkedDataset<float> data(5, 1, 64);
+    for (size_t r = 0; r < samples; ++r) {
+        data.append(X.data() + r * 5, y.data() + r);
+    }
+    assert(data.size() == samples && data.chunk_count() == 16);
+    for (size_t r = 0; r < samples; r += 37) {
+        assert(data.input(r)[4] == X(r, 4) && data.target(r)[0] == y(r, 0));
+    }
+    cout << "✓ Filas repartidas en 16 trozos de 64" << endl;
+
+    // Entrenar desde los trozos da lo mismo que desde los tensores
+    const string model = "test_chunked_dataset.bin";
+    float losses[2];
+    for (int source = 0; source < 2; ++source) {
+        NeuralNetwork<float> nn;
+        nn.add_dense_layer(5, 8);
+        nn.add_activation("tanh");
+        nn.add_dense_layer(8, 1);
+        if (source == 0) {
+            nn.save(model);
+        } else {
+            nn.load(model);
+        }
+        nn.set_optimizer("sgd", 0.05f);
+        nn.set_batch_size(100, false);
+        losses[source] = source == 0 ? nn.train(X, y, 3, false) : nn.train(data, 3, false);
+    }
+    std::remove(model.c_str());
+    assert(approx_equal(losses[0], losses[1], 1e-6));
+    cout << "✓ Mismo entrenamiento desde trozos que desde tensores" << endl;
+
+    // Con spill sólo queda en RAM el trozo que se está llenando, y el archivo
+    // se puede reabrir para seguir agregando
+    const string path = "test_chunked_dataset.data";
+    std::remove(path.c_str());
+    {
+        ChunkedDataset<float> spilled(5, 1, 64);
+        spilled.spill_to(path);
+        for (size_t r = 0; r < samples / 2; ++r) {
+            spilled.append(X.data() + r * 5, y.data() + r);
+        }
+        assert(spilled.resident_bytes() == 64 * 6 * sizeof(float));
+    }
+    {
+        ChunkedDataset<float> reopened(5, 1, 64);
+        reopened.spill_to(path);
+        assert(reopened.size() == samples / 2);
+        for (size_t r = samples / 2; r < samples; ++r) {
+            reopened.append(X.data() + r * 5, y.data() + r);
+        }
+        assert(reopened.spilled_chunks() == 15 && reopened.resident_bytes() == 64 * 6 * sizeof(float));
+        assert(reopened.checksum() == data.checksum());
+    }
+    ChunkedDataset<float> other(4, 1, 64);
+    bool threw = false;
+    try {
+        other.spill_to(path);
+    } catch (const runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+    std::remove(path.c_str());
+    cout << "✓ Spill a disco con un trozo residente; reabierto continúa igual" << endl;
+
+    threw = false;
+    try {
+        ChunkedDataset<float> bad(5, 1, 100);
+    } catch (const invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    cout << "¡Todas las pruebas del dataset pasaron!" << endl << endl;
+}
+
+void test_concurrency_primitives() {
+    cout << "=== Probando cola SPSC y doble buffer ===" << endl;
+
+    // La cola entrega todo en orden entre dos hilos
+    const size_t count = 200000;
+    utec::parallel::SpscQueue<size_t> queue(1024);
+    thread producer([&] {
+        for (size_t i = 0; i < count; ++i) {
+            while (!queue.try_push(i)) this_thread::yield();
+        }
+    });
+    size_t expected = 0, value;
+    while (expected < count) {
+        if (queue.try_pop(value)) {
+            assert(value == expected);
+            ++expected;
+        }
+    }
+    producer.join();
+    assert(!queue.try_pop(value));
+    assert(queue.pushed() == count);
+    cout << "✓ Cola SPSC entrega " << count << " valores en orden" << endl;
+
+    // Llena: descarta y cuenta, sin asignar memoria
+    struct Record { float state[5]; float target; };
+    utec::parallel::SpscQueue<Record> records(8);
+    size_t before = allocation_count.load();
+    for (int i = 0; i < 10; ++i) {
+        records.try_push(Record{{float(i), 0, 0, 0, 0}, float(i)});
+    }
+    size_t allocations = allocation_count.load() - before;
+    assert(records.size() == 8 && records.pushed() == 8 && records.dropped() == 2);
+    float sum = 0.0f;
+    assert(records.consume([&sum](const Record& r) { sum += r.target; }, 5) == 5);
+    assert(sum == 0 + 1 + 2 + 3 + 4 && records.size() == 3);
+    assert(records.try_push(Record{}) && allocations == 0);
+    cout << "✓ Cola llena: 2 descartadas contadas, 0 asignaciones" << endl;
+
+    // El lector nunca ve una copia a medio escribir
+    utec::parallel::DoubleBuffer<array<int, 256>> buffer;
+    const int versions = 2000;
+    atomic<bool> done{false};
+    thread writer([&] {
+        for (int v = 1; v <= versions; ++v) {
+            buffer.write([v](array<int, 256>& copy) { copy.fill(v); });
+        }
+        done = true;
+    });
+    int last = 0;
+    size_t reads = 0;
+    while (!done || last < versions) {
+        int seen = buffer.read([](const array<int, 256>& copy) {
+            for (int x : copy) assert(x == copy[0]);
+            return copy[0];
+        });
+        assert(seen >= last);
+        last = seen;
+        ++reads;
+    }
+    writer.join();
+    assert(buffer.version() == uint64_t(versions));
+    cout << "✓ Doble buffer: " << reads << " lecturas sin copias incompletas" << endl;
+
+    cout << "¡Todas las pruebas de concurrencia pasaron!" << endl << endl;
+}
+
+void test_random_streams() {
+    cout << "=== Probando generador reproducible ===" << endl;
+    namespace rnd = utec::random;
+
+    // Basado en contador: saltar n valores es lo mismo que generarlos
+    rnd::SplitMix64 a(123), b(123);
+    for (int i = 0; i < 1000; ++i) a();
+    b.discard(1000);
+    assert(a() == b());
+    assert(rnd::make_stream(1, 0)() != rnd::make_stream(1, 1)());
+    assert(rnd::make_stream(1, 0)() != rnd::make_stream(2, 0)());
+
+    // Distribuciones propias: rango y momentos
+    auto rng = rnd::make_stream(5, 0);
+    double sum = 0.0, sum_sq = 0.0;
+    const int n = 100000;
+    for (int i = 0; i < n; ++i) {
+        float u = rnd::uniform(rng, -2.0f, 3.0f);
+        assert(u >= -2.0f && u < 3.0f);
+        double z = rnd::normal<double>(rng);
+        sum += z;
+        sum_sq += z * z;
+    }
+    assert(std::abs(sum / n) < 0.02 && std::abs(sum_sq / n - 1.0) < 0.03);
+    vector<int> order(100);
+    iota(order.begin(), order.end(), 0);
+    rnd::shuffle(order.begin(), order.end(), rng);
+    vector<int> sorted = order;
+    sort(sorted.begin(), sorted.end());
+    for (int i = 0; i < 100; ++i) assert(sorted[i] == i);
+    cout << "✓ discard O(1), flujos independientes, uniforme, normal y barajado" << endl;
+
+    // Con la misma semilla global: mismos pesos, mismos tensores y el mismo
+    // entrenamiento bit a bit con 4 hilos
+    Tensor<float, 2> X(512, 5), y(512, 1);
+    rnd::seed(11);
+    X.random_fill(-1.0f, 1.0f);
+    y.random_fill(-1.0f, 1.0f);
+    auto train = [&](uint64_t seed) {
+        rnd::seed(seed);
+        NeuralNetwork<float> net;
+        net.add_dense_layer(5, 16);
+        net.add_activation("tanh");
+        net.add_dense_layer(16, 1);
+        net.set_optimizer("adam", 0.01f);
+        net.set_batch_size(128);
+        net.set_num_threads(4);
+        net.train(X, y, 3, false);
+        return net.get_parameters();
+    };
+    auto first = train(42);
+    assert(train(42) == first);
+    assert(train(43) != first);
+    Tensor<float, 2> again(512, 5);
+    rnd::seed(11);
+    again.random_fill(-1.0f, 1.0f);
+    for (size_t i = 0; i < X.size(); ++i) assert(again.data()[i] == X.data()[i]);
+    cout << "✓ Misma semilla, mismo entrenamiento bit a bit (" << first.size() << " parámetros)" << endl;
+
+    cout << "¡Todas las pruebas del generador pasaron!" << endl << endl;
+}
+
+void test_profiler() {
+    cout << "=== Probando el perfilador ===" << endl;
+    using utec::profiling::Profiler;
+    using utec::profiling::ZoneTotal;
+    Profiler& profiler = Profiler::instance();
+    const char* work = "test::work";
+    const char* other = "test::other";
+    auto total = [&profiler](const char* name) {
+        for (const auto& zone : profiler.zones()) {
+            if (zone.name == name) return zone;
+        }
+        return ZoneTotal{name, 0.0, 0};
+    };
+
+    // Zonas de dos hilos se suman en el fotograma que las cierra
+    profiler.frame();
+    {
+        utec::profiling::Zone zone(work);
+        this_thread::sleep_for(chrono::milliseconds(2));
+    }
+    thread worker([&] {
+        profiler.set_thread_name("trabajador");
+        for (int i = 0; i < 3; ++i) {
+            utec::profiling::Zone zone(other);
+        }
+        utec::profiling::count("test.counter", 42.0);
+    });
+    worker.join();
+    profiler.frame();
+    assert(total(work).calls == 1 && total(work).ms >= 2.0);
+    assert(total(other).calls == 3);
+    assert(profiler.frames() >= 1 && profiler.frame_ms(0) >= 2.0f);
+
+    // El fotograma siguiente empieza en cero
+    profiler.frame();
+    assert(total(work).calls == 0 && total(other).calls == 0);
+    cout << "✓ Totales por fotograma de varios hilos" << endl;
+
+    // Apagado en ejecución no registra nada
+    profiler.set_enabled(false);
+    { utec::profiling::Zone zone(work); }
+    profiler.set_enabled(true);
+    profiler.frame();
+    assert(total(work).calls == 0);
+
+    // Sin PONGSASOS_PROFILE las macros no generan nada
+    { PROFILE_ZONE("test::macro"); }
+    profiler.frame();
+    assert(total("test::macro").calls == (utec::profiling::compiled_in ? 1u : 0u));
+
+    // Un anillo lleno conserva sólo los eventos más recientes
+    const size_t extra = 100;
+    for (size_t i = 0; i < utec::profiling::ThreadRing::capacity + extra; ++i) {
+        profiler.zone(work, i, i + 1000);
+    }
+    profiler.frame();
+    assert(total(work).calls == utec::profiling::ThreadRing::retained);
+    cout << "✓ Apagado, macros y anillo lleno" << endl;
+
+    // Traza de Chrome: metadatos por hilo, zonas y contadores
+    const string path = "test_profiler_trace.json";
+    size_t events = profiler.write_chrome_trace(path);
+    ifstream in(path);
+    string text((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+    assert(events > utec::profiling::ThreadRing::retained);
+    assert(text.find("\"traceEvents\"") != string::npos && text.find("\"trabajador\"") != string::npos);
+    assert(text.find("\"test.counter\", \"ph\": \"C\"") != string::npos);
+    assert(text.substr(text.size() - 3) == "]}\n");
+    cout << "✓ Traza de Chrome con " << events << " eventos" << endl;
+
+    // Los hilos que terminan dejan su anillo para los siguientes
+    auto threads_in_trace = [&path, &profiler]() {
+        profiler.write_chrome_trace(path);
+        ifstream in(path);
+        string text((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        size_t count = 0;
+        for (size_t at = text.find("\"thread_name\""); at != string::npos; at = text.find("\"thread_name\"", at + 1)) {
+            ++count;
+        }
+        return count;
+    };
+    size_t threads = threads_in_trace();
+    for (int i = 0; i < 4; ++i) {
+        thread([&] { utec::profiling::Zone zone(other); }).join();
+    }
+    assert(threads_in_trace() == threads);
+    std::remove(path.c_str());
+    cout << "✓ " << threads << " anillos reutilizados por hilos nuevos" << endl;
+
+    cout << "¡Todas las pruebas del perfilador pasaron!" << endl << endl;
+}
+
+void test_workspace_allocations() {
+    cout << "=== Probando workspace de entrenamiento sin asignaciones ===" << endl;
+
+    const size_t samples = 1000;
+    Tensor<float, 2> X(samples, 5);
+    Tensor<float, 2> y(samples, 1);
+    X.random_fill(-1.0f, 1.0f);
+    for (size_t i = 0; i < samples; i++) {
+        y(i, 0) = 0.5f * (X(i, 1) - X(i, 4));
+    }
+
+    for (size_t threads : {1, 4}) {
+        NeuralNetwork<float> nn;
+        nn.add_dense_layer(5, 16);
+        nn.add_activation("tanh");
+        nn.add_dense_layer(16, 16);
+        nn.add_activation("tanh");
+        nn.add_dense_layer(16, 1);
+        nn.set_optimizer("sgd", 0.05f);
+        nn.set_batch_size(128);
+        nn.set_num_threads(threads);
+
+        // Calentamiento: la primera época planifica los workspaces
+        nn.train(X, y, 1, false);
+        assert(nn.workspace_bytes() > 0);
+
+        size_t before = allocation_count.load();
+        nn.train(X, y, 5, false);
+        size_t allocations = allocation_count.load() - before;
+        cout << threads << " hilo(s): " << allocations << " asignaciones en 5 épocas, workspace de "
+             << nn.workspace_bytes() << " bytes" << endl;
+        assert(allocations == 0);
+    }
+    cout << "✓ Después del calentamiento el entrenamiento no asigna memoria" << endl;
+
+    cout << "¡Todas las pruebas del workspace pasaron!" << endl << endl;
+}
+
+void test_batched_inference() {
+    cout << "=== Probando inferencia por lotes ===" << endl;
+
+    NeuralNetwork<float> nn;
+    nn.add_dense_layer(5, 16);
+    nn.add_activation("tanh");
+    nn.add_dense_layer(16, 1);
+    nn.add_activation("tanh");
+
+    const size_t batch = 300;
+    Tensor<float, 2> X(batch, 5);
+    X.random_fill(-1.0f, 1.0f);
+
+    auto expected = nn.predict(X);
+    const auto& out = nn.predict_batch(X);
+    assert(out.shape()[0] == batch && out.shape()[1] == 1);
+    for (size_t i = 0; i < batch; i++) {
+        assert(approx_equal(out(i, 0), expected(i, 0), 1e-5));
+    }
+    cout << "✓ predict_batch coincide con predict" << endl;
+
+    // Los buffers se reutilizan: misma memoria en la siguiente llamada
+    const float* first = out.data();
+    const auto& again = nn.predict_batch(X);
+    assert(&again == &out && again.data() == first);
+
+    // Un lote más chico tampoco reasigna
+    Tensor<float, 2> row(1, 5);
+    for (size_t j = 0; j < 5; j++) row(0, j) = X(7, j);
+    const auto& single = nn.predict_batch(row);
+    assert(single.shape()[0] == 1 && single.data() == first);
+    assert(approx_equal(single(0, 0), expected(7, 0), 1e-5));
+    cout << "✓ Los buffers intermedios se reutilizan entre llamadas" << endl;
+
+    cout << "¡Todas las pruebas de inferencia por lotes pasaron!" << endl << endl;
+}
+
+void test_static_network() {
+    cout << "=== Probando red de arquitectura fija ===" << endl;
+
+    auto make = [](size_t hidden) {
+        NeuralNetwork<float> nn;
+        nn.add_dense_layer(5, hidden);
+        nn.add_activation("tanh");
+        nn.add_dense_layer(hidden, 16);
+        nn.add_activation("tanh");
+        nn.add_dense_layer(16, 1);
+        nn.add_activation("tanh");
+        return nn;
+    };
+    using Policy = StaticNetwork<float, 5, 16, 16, 1>;
+    static_assert(Policy::input_size == 5 && Policy::output_size == 1 && Policy::layer_count == 3);
+
+    NeuralNetwork<float> nn = make(16);
+    Policy policy(nn);
+
+    const size_t batch = 100;
+    Tensor<float, 2> X(batch, 5);
+    X.random_fill(-1.0f, 1.0f);
+    const auto& expected = nn.predict_batch(X);
+    for (size_t i = 0; i < batch; i++) {
+        Policy::Input state;
+        for (size_t j = 0; j < 5; j++) state[j] = X(i, j);
+        assert(approx_equal(policy.predict(state)[0], expected(i, 0), 1e-6));
+    }
+    cout << "✓ StaticNetwork coincide con NeuralNetwork" << endl;
+
+    // Carga directa del archivo de NeuralNetwork::save
+    const string path = "test_static_model.bin";
+    nn.save(path);
+    Policy loaded;
+    loaded.load(path);
+    Policy::Input state = {0.5f, 0.3f, 0.1f, -0.2f, 0.8f};
+    assert(loaded.predict(state)[0] == policy.predict(state)[0]);
+    cout << "✓ StaticNetwork carga el modelo guardado" << endl;
+
+    // Arquitecturas distintas se rechazan y la red no cambia
+    NeuralNetwork<float> other = make(8);
+    try {
+        loaded.assign(other);
+        assert(false);
+    } catch (const invalid_argument&) {}
+    other.save(path);
+    try {
+        loaded.load(path);
+        assert(false);
+    } catch (const runtime_error&) {}
+    assert(loaded.predict(state)[0] == policy.predict(state)[0]);
+    std::remove(path.c_str());
+    cout << "✓ Arquitecturas distintas rechazadas" << endl;
+
+    cout << "¡Todas las pruebas de la red fija pasaron!" << endl << endl;
+}
+
+void test_quantized_inference() {
+    cout << "=== Probando inferencia cuantizada (bf16/fp16/int8) ===" << endl;
+
+    // Conversiones a 16 bits
+    assert(to_bf16(1.0f) == 0x3F80 && from_bf16(0x3F80) == 1.0f);
+    assert(fabs(from_bf16(to_bf16(1.0f / 3.0f)) * 3.0f - 1.0f) < 1.0f / 256);
+    assert(to_fp16(1.0f) == 0x3C00 && to_fp16(-2.0f) == 0xC000);
+    assert(to_fp16(65504.0f) == 0x7BFF && to_fp16(65520.0f) == 0x7C00);
+    assert(to_fp16(ldexp(1.0f, -24)) == 0x0001 && to_fp16(ldexp(1.0f, -26)) == 0);
+    for (uint32_t h = 0; h <= 0xFFFF; ++h) {
+        bool nan = (h & 0x7C00) == 0x7C00 && (h & 0x3FF) != 0;
+        if (!nan) assert(to_fp16(from_fp16(uint16_t(h))) == h);
+    }
+    cout << "✓ bf16/fp16 con redondeo al par; fp16 ida y vuelta exacto" << endl;
+
+    NeuralNetwork<float> nn;
+    nn.add_dense_layer(5, 16);
+    nn.add_activation("tanh");
+    nn.add_dense_layer(16, 16);
+    nn.add_activation("tanh");
+    nn.add_dense_layer(16, 1);
+    nn.add_activation("tanh");
+
+    Tensor<float, 2> calibration(2000, 5), held_out(500, 5);
+    calibration.random_fill(-1.0f, 1.0f);
+    held_out.random_fill(-1.0f, 1.0f);
+    const Tensor<float, 2> expected = nn.predict_batch(held_out);
+
+    auto max_error = [&](QuantizedNetwork& q) {
+        const auto& out = q.predict_batch(held_out);
+        float error = 0.0f;
+        for (size_t i = 0; i < out.size(); ++i) error = max(error, fabs(out.data()[i] - expected.data()[i]));
+        return error;
+    };
+
+    QuantizedNetwork fp32(nn, Precision::fp32), bf16(nn, Precision::bf16), fp16(nn, Precision::fp16);
+    assert(max_error(fp32) < 1e-6f && max_error(bf16) < 2e-2f && max_error(fp16) < 2e-3f);
+    assert(bf16.weight_bytes() * 2 == fp32.weight_bytes());
+    cout << "✓ Pesos bf16/fp16: error máximo " << max_error(bf16) << " / " << max_error(fp16) << endl;
+
+    // int8: cerca de fp32 y misma decisión (umbral 0.1) casi siempre
+    QuantizedNetwork int8(nn, Precision::int8, calibration);
+    assert(int8.weight_bytes() < fp32.weight_bytes() / 2);
+    float error = max_error(int8);
+    const auto& actions = int8.predict_batch(held_out);
+    auto direction = [](float action) { return action > 0.1f ? 1 : (action < -0.1f ? -1 : 0); };
+    size_t agree = 0;
+    for (size_t i = 0; i < held_out.shape()[0]; ++i) {
+        agree += direction(actions(i, 0)) == direction(expected(i, 0));
+    }
+    assert(error < 0.05f && agree >= held_out.shape()[0] * 95 / 100);
+    cout << "✓ int8: error máximo " << error << ", " << agree << "/" << held_out.shape()[0]
+         << " decisiones iguales a fp32" << endl;
+
+    // Calibrar con un dataset da lo mismo
+    ChunkedDataset<float> states(5, 1, 64);
+    for (size_t r = 0; r < calibration.shape()[0]; ++r) {
+        float target = 0.0f;
+        states.append(calibration.data() + r * 5, &target);
+    }
+    QuantizedNetwork from_dataset(nn, Precision::int8, states);
+    const Tensor<float, 2> reference = int8.predict_batch(held_out);
+    const auto& same = from_dataset.predict_batch(held_out);
+    assert(equal(same.data(), same.data() + same.size(), reference.data()));
+
+    // Los kernels int8 coinciden en cada ISA, con bordes (13 entradas, 20
+    // salidas) y entradas fuera de la escala (se saturan)
+    const size_t in = 13, out = 20, groups = 4, out_padded = 32, rows = 7;
+    vector<int8_t> w(groups * out_padded * 4, 0), scratch(16);
+    vector<int32_t> offsets(out_padded, 0);
+    vector<float> inverse_scale(16, 0.0f), scale(out_padded, 0.0f), bias(out_padded, 0.0f);
+    for (size_t i = 0; i < in; ++i) {
+        inverse_scale[i] = 20.0f + float(i);
+        for (size_t j = 0; j < out; ++j) {
+            int8_t q = int8_t((i * 37 + j * 91) % 255) - 127;
+            w[((i / 4) * out_padded + j) * 4 + i % 4] = q;
+            offsets[j] += 128 * q;
+        }
+    }
+    for (size_t j = 0; j < out; ++j) {
+        scale[j] = 0.001f * float(j + 1);
+        bias[j] = 0.1f * float(j) - 1.0f;
+    }
+    quantized_detail::PackedLayer layer{in, out, groups, out_padded, w.data(), offsets.data(),
+                                        inverse_scale.data(), scale.data(), bias.data()};
+    Tensor<float, 2> x(rows, in), y_ref(rows, out), y(rows, out);
+    x.random_fill(-8.0f, 8.0f);
+    quantized_detail::layer_scalar(layer, x.data(), rows, y_ref.data(), scratch.data());
+    for (auto isa : {gemm::Isa::scalar, gemm::Isa::avx2, gemm::Isa::avx512}) {
+        gemm::force_isa(isa);
+        quantized_detail::layer_kernel()(layer, x.data(), rows, y.data(), scratch.data());
+        for (size_t i = 0; i < y.size(); ++i) {
+            assert(approx_equal(y.data()[i], y_ref.data()[i], 1e-5f * (1.0f + fabs(y_ref.data()[i]))));
+        }
+    }
+    gemm::force_isa(gemm::detected_isa());
+    cout << "✓ Kernels int8 escalar/AVX2/VNNI coinciden" << endl;
+
+    // Sin calibración o con otra arquitectura se rechaza
+    try {
+        QuantizedNetwork bad(nn, Precision::int8);
+        assert(false);
+    } catch (const invalid_argument&) {}
+    NeuralNetwork<float> sigmoid;
+    sigmoid.add_dense_layer(5, 4);
+    sigmoid.add_activation("sigmoid");
+    try {
+        QuantizedNetwork bad(sigmoid, Precision::bf16);
+        assert(false);
+    } catch (const invalid_argument&) {}
+    cout << "✓ Sin calibración o con otra arquitectura se rechaza" << endl;
+
+    cout << "¡Todas las pruebas de inferencia cuantizada pasaron!" << endl << endl;
+}
+
+void test_layer_fusion() {
+    cout << "=== Probando fusión Dense + activación ===" << endl;
+
+    // Dos redes con los mismos pesos iniciales: una fusionada y otra no
+    const string path = "test_fusion_model.bin";
+    NeuralNetwork<float> fused;
+    fused.add_dense_layer(5, 16);
+    fused.add_activation("tanh");
+    fused.add_dense_layer(16, 16);
+    fused.add_activation("relu");
+    fused.add_dense_layer(16, 1);
+    fused.add_activation("sigmoid");
+    fused.save(path);
+
+    NeuralNetwork<float> plain;
+    plain.load(path);
+    plain.set_layer_fusion(false);
+    fused.load(path);
+    std::remove(path.c_str());
+
+    const size_t samples = 1000;
+    Tensor<float, 2> X(samples, 5);
+    Tensor<float, 2> y(samples, 1);
+    X.random_fill(-1.0f, 1.0f);
+    for (size_t i = 0; i < samples; i++) {
+        y(i, 0) = X(i, 0) > X(i, 4) ? 0.9f : 0.1f;
+    }
+
+    // Inferencia: el GEMM con epílogo da lo mismo que capa por capa
+    auto expected = plain.predict_batch(X);
+    const auto& out = fused.predict_batch(X);
+    for (size_t i = 0; i < samples; i++) {
+        assert(approx_equal(out(i, 0), expected(i, 0), 1e-6));
+    }
+    cout << "✓ predict_batch fusionado coincide con las capas separadas" << endl;
+
+    // Entrenamiento: mismo recorrido de mini-batches en ambas redes
+    for (auto* nn : {&fused, &plain}) {
+        nn->set_optimizer("sgd", 0.1f);
+        nn->set_batch_size(100, false);
+        nn->set_num_threads(1);
+        nn->train(X, y, 5, false);
+    }
+    auto after_fused = fused.predict(X);
+    auto after_plain = plain.predict(X);
+    for (size_t i = 0; i < samples; i++) {
+        assert(approx_equal(after_fused(i, 0), after_plain(i, 0), 1e-5));
+    }
+    cout << "✓ Backward fusionado entrena igual que las capas separadas" << endl;
+
+    cout << "¡Todas las pruebas de fusión pasaron!" << endl << endl;
+}
+
+void test_stacked_activation_gradients() {
+    cout << "=== Probando gradientes con activaciones seguidas ===" << endl;
+
+    // Dense -> relu -> sigmoid -> Dense: la segunda activación no puede
+    // escribir sobre la salida de la primera, que ésta lee en backward
+    const size_t samples = 8;
+    Tensor<double, 2> X(samples, 2);
+    Tensor<double, 2> y(samples, 1);
+    X.random_fill(-1.0, 1.0);
+    for (size_t i = 0; i < samples; i++) {
+        y(i, 0) = X(i, 0) * X(i, 1);
+    }
+
+    for (bool fusion : {true, false}) {
+        NeuralNetwork<double> nn;
+        nn.add_dense_layer(2, 3);
+        nn.add_activation("relu");
+        nn.add_activation("sigmoid");
+        nn.add_dense_layer(3, 1);
+        nn.set_layer_fusion(fusion);
+
+        auto loss = [&]() {
+            auto out = nn.predict(X);
+            double sum = 0.0;
+            for (size_t i = 0; i < samples; i++) {
+                double diff = out(i, 0) - y(i, 0);
+                sum += diff * diff;
+            }
+            return sum / samples;
+        };
+
+        // Diferencias centrales sobre cada parámetro
+        const auto theta = nn.get_parameters();
+        const double h = 1e-6;
+        vector<double> numeric(theta.size());
+        for (size_t k = 0; k < theta.size(); k++) {
+            auto shifted = theta;
+            shifted[k] = theta[k] + h;
+            nn.set_parameters(shifted);
+            double plus = loss();
+            shifted[k] = theta[k] - h;
+            nn.set_parameters(shifted);
+            numeric[k] = (plus - loss()) / (2 * h);
+        }
+        nn.set_parameters(theta);
+
+        // Un paso de SGD con lr = 1 sobre el batch completo: θ₁ = θ₀ - g
+        nn.set_optimizer("sgd", 1.0);
+        nn.set_batch_size(0, false);
+        nn.set_num_threads(1);
+        nn.train(X, y, 1, false);
+        const auto after = nn.get_parameters();
+        for (size_t k = 0; k < theta.size(); k++) {
+            assert(approx_equal(theta[k] - after[k], numeric[k], 1e-5));
+        }
+    }
+    cout << "✓ El gradiente coincide con las diferencias finitas (con y sin fusión)" << endl;
+
+    cout << "¡Todas las pruebas de gradientes pasaron!" << endl << endl;
+}
+
+void test_model_serialization() {
+    cout << "=== Probando guardado y carga de modelos ===" << endl;
+
+    const string path = "test_model.bin";
+    Tensor<float, 2> X(64, 5);
+    Tensor<float, 2> y(64, 1);
+    X.random_fill(-1.0f, 1.0f);
+    y.random_fill(-0.5f, 0.5f);
+
+    NeuralNetwork<float> original;
+    original.add_dense_layer(5, 16);
+    original.add_activation("tanh");
+    original.add_dense_layer(16, 1);
+    original.add_activation("sigmoid");
+    original.set_optimizer("sgd", 0.05f);
+    original.train(X, y, 5, false);
+    original.save(path);
+
+    // Otra red con otra arquitectura: load la reemplaza por la guardada
+    NeuralNetwork<float> loaded;
+    loaded.add_dense_layer(5, 3);
+    loaded.load(path);
+    auto expected = original.predict(X);
+    auto actual = loaded.predict(X);
+    for (size_t i = 0; i < 64; i++) {
+        assert(actual(i, 0) == expected(i, 0));
+    }
+    cout << "✓ El modelo cargado predice exactamente lo mismo" << endl;
+
+    // Entrenar el modelo cargado copia los pesos y no toca el archivo
+    loaded.set_optimizer("sgd", 0.05f);
+    loaded.train(X, y, 5, false);
+    NeuralNetwork<float> reloaded;
+    reloaded.load(path);
+    assert(reloaded.predict(X)(0, 0) == expected(0, 0));
+    assert(loaded.predict(X)(0, 0) != expected(0, 0));
+    cout << "✓ Re-entrenar un modelo mapeado no modifica el archivo" << endl;
+
+    // Un byte alterado invalida el checksum
+    {
+        fstream file(path, ios::in | ios::out | ios::binary);
+        file.seekp(200);
+        file.put(char(0x5a));
+    }
+    bool rejected = false;
+    try {
+        reloaded.load(path);
+    } catch (const runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    cout << "✓ Los archivos corruptos se rechazan" << endl;
+
+    // Formas manipuladas con el checksum recalculado: rows * cols se
+    // desborda a 0, o la segunda capa densa no encaja con la primera
+    original.save(path);
+    vector<unsigned char> saved;
+    {
+        ifstream file(path, ios::binary);
+        saved.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    }
+    auto rejects_shape = [&](uint64_t rows, uint64_t cols) {
+        auto bytes = saved;
+        auto* record = reinterpret_cast<serialization::LayerRecord*>(bytes.data() + sizeof(serialization::ModelHeader));
+        record->rows = rows;
+        record->cols = cols;
+        serialization::write_file(path, bytes);
+        try {
+            NeuralNetwork<float>().load(path);
+        } catch (const runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+    assert(rejects_shape(uint64_t{1} << 33, uint64_t{1} << 31));
+    assert(rejects_shape(0, 16));
+    assert(rejects_shape(5, 8));
+    assert(!rejects_shape(5, 16));
+    std::remove(path.c_str());
+    cout << "✓ Las formas inválidas o incompatibles se rechazan" << endl;
+
+    cout << "¡Todas las pruebas de serialización pasaron!" << endl << endl;
+}
+
 void test_pong_scenario() {
     cout << "=== Probando escenario específico de Pong ===" << endl;
 
@@ -186,13 +1267,14 @@ void test_pong_scenario() {
     Tensor<float, 2> X(10, 5);
     Tensor<float, 2> y(10, 1);
 
-    // Llenar con datos aleatorios de ejemplo
+    // Llenar con datos aleatorios de ejemplo (semilla fija)
+    auto rng = utec::random::make_stream(7, 0);
     for (int i = 0; i < 10; i++) {
-        X(i, 0) = float(rand()) / RAND_MAX; // ball_x
-        X(i, 1) = float(rand()) / RAND_MAX; // ball_y
-        X(i, 2) = (float(rand()) / RAND_MAX) * 2 - 1; // ball_speed_x
-        X(i, 3) = (float(rand()) / RAND_MAX) * 2 - 1; // ball_speed_y
-        X(i, 4) = float(rand()) / RAND_MAX; // paddle_y
+        X(i, 0) = utec::random::uniform(rng, 0.0f, 1.0f); // ball_x
+        X(i, 1) = utec::random::uniform(rng, 0.0f, 1.0f); // ball_y
+        X(i, 2) = utec::random::uniform(rng, -1.0f, 1.0f); // ball_speed_x
+        X(i, 3) = utec::random::uniform(rng, -1.0f, 1.0f); // ball_speed_y
+        X(i, 4) = utec::random::uniform(rng, 0.0f, 1.0f); // paddle_y
 
         // Acción objetivo simple: mover hacia la pelota
         y(i, 0) = (X(i, 1) - X(i, 4)) * 0.5f; // Normalizado
@@ -225,8 +1307,24 @@ int main() {
 
     try {
         test_tensor_operations();
+        test_gemm_kernels();
         test_activation_functions();
+        test_activation_kernels();
         test_neural_network();
+        test_minibatch_training();
+        test_optimizers();
+        test_parameter_buffer();
+        test_chunked_dataset();
+        test_concurrency_primitives();
+        test_random_streams();
+        test_profiler();
+        test_workspace_allocations();
+        test_batched_inference();
+        test_model_serialization();
+        test_layer_fusion();
+        test_stacked_activation_gradients();
+        test_static_network();
+        test_quantized_inference();
         test_pong_scenario();
 
         cout << "🎉 ¡TODAS LAS PRUEBAS PASARON EXITOSAMENTE! 🎉" << endl;